@@ -0,0 +1,184 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "blockchain.h"
+#include "hblk_bench.h"
+
+#define NB_BLOCKS	1000
+
+/**
+ * struct fixture_s - Inputs shared by the cases
+ *
+ * @chain: Chain of NB_BLOCKS generated blocks
+ * @block: Last block of @chain
+ * @prev:  Block before @block
+ * @path:  File to serialize @chain to
+ */
+
+typedef struct fixture_s
+{
+	blockchain_t *chain;
+	block_t *block;
+	block_t *prev;
+	char path[32];
+} fixture_t;
+
+/**
+ * _block_create - Creates and destroys a block
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _block_create(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+
+	while (iters--)
+		block_destroy(block_create(f->block, f->block->data.buffer,
+					   f->block->data.len));
+}
+
+/**
+ * _block_hash - Hashes a block
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _block_hash(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+	uint8_t hash[SHA256_DIGEST_LENGTH];
+
+	while (iters--)
+		HBLK_BENCH_KEEP(block_hash(f->block, hash));
+}
+
+/**
+ * _hash_matches_difficulty - Checks the difficulty of a hash
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _hash_matches_difficulty(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+	int match;
+
+	while (iters--)
+	{
+		match = hash_matches_difficulty(f->block->hash,
+						f->block->info.difficulty);
+		HBLK_BENCH_KEEP(match);
+	}
+}
+
+/**
+ * _block_is_valid - Validates the last block against the previous one
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _block_is_valid(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+	int valid;
+
+	while (iters--)
+	{
+		valid = block_is_valid(f->block, f->prev);
+		HBLK_BENCH_KEEP(valid);
+	}
+}
+
+/**
+ * _blockchain_difficulty - Computes the difficulty of the next block
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _blockchain_difficulty(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+	uint32_t difficulty;
+
+	while (iters--)
+	{
+		difficulty = blockchain_difficulty(f->chain);
+		HBLK_BENCH_KEEP(difficulty);
+	}
+}
+
+/**
+ * _serialize - Serializes the chain to a file
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _serialize(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+
+	while (iters--)
+		blockchain_serialize(f->chain, f->path);
+}
+
+/**
+ * _deserialize - Deserializes the chain from a file
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _deserialize(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+
+	while (iters--)
+		blockchain_destroy(blockchain_deserialize(f->path));
+}
+
+/**
+ * main - Runs every case of the blockchain, on a generated chain
+ *
+ * @ac: Arguments count
+ * @av: Arguments vector, see hblk_bench_init()
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(int ac, char **av)
+{
+	hblk_gen_t gen = {0};
+	hblk_bench_t bench;
+	fixture_t f;
+	int ret;
+
+	if (hblk_bench_init(&bench, ac, av) != 0)
+		return (EXIT_FAILURE);
+	gen.count = NB_BLOCKS;
+	gen.seed = 1;
+	gen.data_max = BLOCKCHAIN_DATA_MAX;
+	gen.interval = BLOCK_GENERATION_INTERVAL;
+	f.chain = blockchain_generate(&gen);
+	if (!f.chain)
+		return (EXIT_FAILURE);
+	f.block = llist_get_tail(f.chain->chain);
+	f.prev = llist_get_node_at(f.chain->chain, NB_BLOCKS - 1);
+	sprintf(f.path, "/tmp/hblk_bench.%d.hblk", (int)getpid());
+	blockchain_serialize(f.chain, f.path);
+
+	ret = hblk_bench_run(&bench, "block_create", _block_create, &f) |
+		hblk_bench_run(&bench, "block_hash", _block_hash, &f) |
+		hblk_bench_run(&bench, "hash_matches_difficulty",
+			       _hash_matches_difficulty, &f) |
+		hblk_bench_run(&bench, "block_is_valid", _block_is_valid, &f) |
+		hblk_bench_run(&bench, "blockchain_difficulty",
+			       _blockchain_difficulty, &f) |
+		hblk_bench_run(&bench, "serialize/1000", _serialize, &f) |
+		hblk_bench_run(&bench, "deserialize/1000", _deserialize, &f) |
+		hblk_bench_finish(&bench);
+
+	remove(f.path);
+	blockchain_destroy(f.chain);
+	return (ret ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -27,7 +27,7 @@
 block_t *block_create(block_t const *prev, int8_t const *data,
 		      uint32_t data_len)
 {
-	block_t *block = calloc(1, sizeof(block_t));
+	block_t *block;
 
 	if (!prev || !data)
 	{
@@ -35,6 +35,8 @@ block_t *block_create(block_t const *prev, int8_t const *data,
 		return (NULL);
 	}
 
+	block = calloc(1, sizeof(block_t));
+	HBLK_STAT_ADD(HBLK_STAT_BLOCK_ALLOC, block != NULL);
 	if (!block)
 	{
 		fprintf(stderr, "block_create: Memory allocation failed.\n");
@@ -37,6 +37,8 @@ uint8_t *block_hash(block_t const *block,
 	       block->data.len);
 
 	SHA256(data_to_hash, data_size, hash_buf);
+	HBLK_STAT_ADD(HBLK_STAT_BLOCK_HASH, 1);
+	HBLK_STAT_ADD(HBLK_STAT_BLOCK_HASH_BYTES, data_size);
 
 	free(data_to_hash);
 
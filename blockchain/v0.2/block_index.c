@@ -0,0 +1,97 @@
+#include "blockchain.h"
+
+/**
+ * block_index_init - program that initializes an empty block index
+ *
+ * @index: a pointer to the index to initialize
+ *
+ * Return: 0 on success, -1 if the slots could not be allocated
+ */
+
+int block_index_init(block_index_t *index)
+{
+	if (!index)
+		return (-1);
+
+	index->slots = calloc(BLOCK_INDEX_MIN_SLOTS, sizeof(*index->slots));
+	if (!index->slots)
+		return (-1);
+
+	index->capacity = BLOCK_INDEX_MIN_SLOTS;
+	index->count = 0;
+
+	return (0);
+}
+
+
+
+/**
+ * block_index_clear - program that frees the nodes and slots of
+ * a block index
+ *
+ * the blocks of the active chain are owned by the chain and are not freed;
+ * the blocks of the side branches are owned by the index and are freed
+ *
+ * @index: a pointer to the index to clear
+ *
+ * Return: nothing (void)
+ */
+
+void block_index_clear(block_index_t *index)
+{
+	uint32_t i;
+
+	if (!index)
+		return;
+
+	for (i = 0; index->slots && i < index->capacity; i++)
+	{
+		if (!index->slots[i])
+			continue;
+		if (!index->slots[i]->active)
+			free(index->slots[i]->block);
+		free(index->slots[i]);
+	}
+	free(index->slots);
+	index->slots = NULL;
+	index->capacity = 0;
+	index->count = 0;
+}
+
+
+
+/**
+ * block_index_find - program that looks up a block node by its hash
+ *
+ * the probe starts at the slot derived from the hash and walks the table
+ * until the block or a free slot is found; since the table is never more
+ * than half full, this takes a constant number of probes on average
+ *
+ * @index: a pointer to the index to search
+ * @hash: the hash of the block to look for
+ *
+ * Return: a pointer to the node of the matching block, or NULL if it is
+ *         not indexed
+ */
+
+block_node_t *block_index_find(block_index_t const *index,
+			       uint8_t const hash[SHA256_DIGEST_LENGTH])
+{
+	uint32_t mask, slot;
+	block_node_t *node;
+
+	if (!index || !index->slots || !hash)
+		return (NULL);
+
+	mask = index->capacity - 1;
+	slot = BLOCK_INDEX_KEY(hash) & mask;
+
+	while ((node = index->slots[slot]) != NULL)
+	{
+		if (!memcmp(node->block->hash, hash, SHA256_DIGEST_LENGTH))
+			return (node);
+		slot = (slot + 1) & mask;
+	}
+
+	return (NULL);
+}
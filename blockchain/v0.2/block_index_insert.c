@@ -0,0 +1,180 @@
+#include "blockchain.h"
+
+/**
+ * block_index_grow - program that doubles the number of slots of an index
+ *
+ * every node is re-inserted in the new table, at the slot derived from
+ * its block's hash and the new capacity
+ *
+ * @index: a pointer to the index to grow
+ *
+ * Return: 0 on success, -1 if the new slots could not be allocated
+ */
+
+static int block_index_grow(block_index_t *index)
+{
+	block_node_t **slots;
+	uint32_t capacity, mask, slot, i;
+
+	capacity = index->capacity * 2;
+	slots = calloc(capacity, sizeof(*slots));
+	if (!slots)
+		return (-1);
+
+	mask = capacity - 1;
+	for (i = 0; i < index->capacity; i++)
+	{
+		if (!index->slots[i])
+			continue;
+		slot = BLOCK_INDEX_KEY(index->slots[i]->block->hash) & mask;
+		while (slots[slot])
+			slot = (slot + 1) & mask;
+		slots[slot] = index->slots[i];
+	}
+
+	free(index->slots);
+	index->slots = slots;
+	index->capacity = capacity;
+
+	return (0);
+}
+
+
+
+/**
+ * block_node_create - program that creates the tree node of a block
+ *
+ * the node is linked to the node of its parent, if it is indexed, and its
+ * cumulative work is the parent's plus the block's own;
+ * the node is created off the active chain
+ *
+ * @index: a pointer to the index holding the parent
+ * @block: a pointer to the block
+ *
+ * Return: a pointer to the new node, or NULL if the allocation failed
+ */
+
+static block_node_t *block_node_create(block_index_t const *index,
+				       block_t *block)
+{
+	block_node_t *node = calloc(1, sizeof(*node));
+	uint64_t work;
+
+	if (!node)
+		return (NULL);
+
+	node->block = block;
+	if (block->info.index != 0)
+		node->parent = block_index_find(index, block->info.prev_hash);
+
+	work = BLOCK_WORK(block->info.difficulty);
+	node->work = node->parent ? node->parent->work : 0;
+	node->work = UINT64_MAX - node->work < work ? UINT64_MAX :
+		node->work + work;
+
+	return (node);
+}
+
+
+
+/**
+ * block_index_insert - program that adds a block to a block index
+ *
+ * the block is keyed on its hash, which must already be computed;
+ * inserting a block whose hash is already indexed returns the existing
+ * node
+ *
+ * @index: a pointer to the index to add the block to
+ * @block: a pointer to the block to index
+ *
+ * Return: a pointer to the node of the block, or NULL on failure
+ */
+
+block_node_t *block_index_insert(block_index_t *index, block_t *block)
+{
+	uint32_t mask, slot;
+
+	if (!index || !index->slots || !block)
+		return (NULL);
+
+	if ((index->count + 1) * 2 > index->capacity &&
+	    block_index_grow(index) != 0)
+		return (NULL);
+
+	mask = index->capacity - 1;
+	slot = BLOCK_INDEX_KEY(block->hash) & mask;
+
+	while (index->slots[slot])
+	{
+		if (!memcmp(index->slots[slot]->block->hash, block->hash,
+			    SHA256_DIGEST_LENGTH))
+			return (index->slots[slot]);
+		slot = (slot + 1) & mask;
+	}
+
+	index->slots[slot] = block_node_create(index, block);
+	if (!index->slots[slot])
+		return (NULL);
+	index->count++;
+
+	return (index->slots[slot]);
+}
+
+
+
+/**
+ * index_block - program that adds a single block of a chain to an index
+ *
+ * this function is called by llist_for_each() from block_index_sync()
+ *
+ * @node: a pointer to the block to index
+ * @idx: the position of the block in the chain (unused)
+ * @arg: a pointer to the index
+ *
+ * Return: 0 to continue the iteration, 1 to stop it on failure
+ */
+
+static int index_block(llist_node_t node, unsigned int idx, void *arg)
+{
+	block_node_t *tree_node;
+
+	(void)idx;
+
+	tree_node = block_index_insert((block_index_t *)arg, (block_t *)node);
+	if (!tree_node)
+		return (1);
+	tree_node->active = 1;
+
+	return (0);
+}
+
+
+
+/**
+ * block_index_sync - program that indexes every block of a chain
+ *
+ * blocks appended with blockchain_add_block() are indexed as they come;
+ * this is only needed after adding blocks to the list directly
+ *
+ * @index: a pointer to the index to update
+ * @chain: the list of blocks to index
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int block_index_sync(block_index_t *index, llist_t *chain)
+{
+	block_t *tail;
+
+	if (!index || !chain)
+		return (-1);
+
+	llist_for_each(chain, index_block, index);
+
+	/* The iteration stops at the first failure, leaving the tail out */
+	tail = llist_get_tail(chain);
+	if (tail && !block_index_find(index, tail->hash))
+		return (-1);
+
+	return (0);
+}
@@ -0,0 +1,48 @@
+#include "blockchain.h"
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+/**
+ * block_info_swap - program that swaps the endianness of an array of
+ * block infos
+ *
+ * this is used to load a .hblk file written on a machine with a different
+ * endianness; instead of swapping every field byte by byte, the first
+ * 16 bytes of an info (index, difficulty and timestamp) are swapped at
+ * once with a single SSSE3 byte shuffle when available (or bswap
+ * instructions otherwise), and the nonce with a bswap instruction;
+ * prev_hash is a byte array and is left untouched
+ *
+ * @infos: a pointer to the first info of the array
+ * @n: the number of infos in the array
+ *
+ * Return: nothing (void)
+ */
+
+void block_info_swap(block_info_t *infos, size_t n)
+{
+	size_t i;
+#ifdef __SSSE3__
+	__m128i const mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+					   15, 14, 13, 12, 11, 10, 9, 8);
+	__m128i head;
+
+	for (i = 0; i < n; i++)
+	{
+		head = _mm_loadu_si128((__m128i const *)&infos[i]);
+		_mm_storeu_si128((__m128i *)&infos[i],
+				 _mm_shuffle_epi8(head, mask));
+		infos[i].nonce = __builtin_bswap64(infos[i].nonce);
+	}
+#else
+	for (i = 0; i < n; i++)
+	{
+		infos[i].index = __builtin_bswap32(infos[i].index);
+		infos[i].difficulty = __builtin_bswap32(infos[i].difficulty);
+		infos[i].timestamp = __builtin_bswap64(infos[i].timestamp);
+		infos[i].nonce = __builtin_bswap64(infos[i].nonce);
+	}
+#endif
+}
@@ -1,27 +1,15 @@
 #include "blockchain.h"
 
 /**
- * block_is_valid - program that validates a block within a blockchain context
- *
- * This function checks whether a given block adheres to the blockchain's
- * validity criteria, including its relationship with the previous block,
- * its index, and the integrity of its hash values
+ * block_check - program that runs the validity checks of a block
  *
- * @block: a pointer to the block to be validated;
- *         it should not be NULL except for the genesis block
- *         which is the first block in the chain
- * @prev_block: a pointer to the block immediately preceding the current block
- *              in the blockchain;
- *              this should be NULL if and only if the block being validated
- *              is the genesis block
+ * @block: a pointer to the block to validate
+ * @prev_block: a pointer to the previous block, NULL for the genesis block
  *
- * Return: 0 if the block is valid according to the blockchain's criteria;
- *         1 if the block is invalid, if any of the validation checks fail,
- *         or if any parameters are incorrectly provided (such as a
- *         NULL block pointer when not validating the genesis block)
+ * Return: 0 if the block is valid, 1 otherwise
  */
 
-int block_is_valid(block_t const *block, block_t const *prev_block)
+static int block_check(block_t const *block, block_t const *prev_block)
 {
 	block_t const tmp = GENESIS_BLOCK;
 	uint8_t hash[SHA256_DIGEST_LENGTH] = {0};
@@ -51,3 +39,37 @@ int block_is_valid(block_t const *block, block_t const *prev_block)
 
 	return (0);
 }
+
+
+
+/**
+ * block_is_valid - program that validates a block within a blockchain context
+ *
+ * This function checks whether a given block adheres to the blockchain's
+ * validity criteria, including its relationship with the previous block,
+ * its index, and the integrity of its hash values
+ *
+ * @block: a pointer to the block to be validated;
+ *         it should not be NULL except for the genesis block
+ *         which is the first block in the chain
+ * @prev_block: a pointer to the block immediately preceding the current block
+ *              in the blockchain;
+ *              this should be NULL if and only if the block being validated
+ *              is the genesis block
+ *
+ * Return: 0 if the block is valid according to the blockchain's criteria;
+ *         1 if the block is invalid, if any of the validation checks fail,
+ *         or if any parameters are incorrectly provided (such as a
+ *         NULL block pointer when not validating the genesis block)
+ */
+
+int block_is_valid(block_t const *block, block_t const *prev_block)
+{
+	uint64_t start = HBLK_STAT_NOW(), span = HBLK_TRACE_BEGIN();
+	int ret = block_check(block, prev_block);
+
+	HBLK_LATENCY(HBLK_LAT_BLOCK_VALID, start);
+	HBLK_TRACE_END("block_is_valid", span);
+
+	return (ret);
+}
@@ -16,7 +16,7 @@ void block_mine(block_t *block)
 {
 	uint8_t hash_buf[SHA256_DIGEST_LENGTH];
 	block_info_t *info;
-	uint64_t nonce = 0;
+	uint64_t nonce = 0, span = HBLK_TRACE_BEGIN();
 	int match;
 
 	info = &block->info;
@@ -29,4 +29,5 @@ void block_mine(block_t *block)
 	} while (match == 0);
 
 	memcpy(block->hash, hash_buf, SHA256_DIGEST_LENGTH);
+	HBLK_TRACE_END("block_mine", span);
 }
@@ -0,0 +1,148 @@
+#include "blockchain.h"
+
+/**
+ * block_queue_create - program that creates a block submission queue
+ *
+ * @capacity: the maximum number of queued blocks;
+ *            it is rounded up to the next power of 2
+ *
+ * Return: a pointer to the new queue, or NULL on failure
+ */
+
+block_queue_t *block_queue_create(size_t capacity)
+{
+	block_queue_t *queue;
+	size_t size = 2, i;
+
+	while (size < capacity)
+		size *= 2;
+
+	queue = aligned_alloc(64, (sizeof(*queue) + 63) / 64 * 64);
+	if (!queue)
+		return (NULL);
+	memset(queue, 0, sizeof(*queue));
+
+	queue->cells = calloc(size, sizeof(*queue->cells));
+	if (!queue->cells)
+	{
+		free(queue);
+		return (NULL);
+	}
+
+	for (i = 0; i < size; i++)
+		atomic_init(&queue->cells[i].seq, i);
+	queue->mask = size - 1;
+
+	return (queue);
+}
+
+
+
+/**
+ * block_queue_destroy - program that frees a block submission queue
+ *
+ * no producer may be pushing anymore; the blocks still queued are freed
+ * as well
+ *
+ * @queue: a pointer to the queue to free
+ *
+ * Return: nothing (void)
+ */
+
+void block_queue_destroy(block_queue_t *queue)
+{
+	block_t *block;
+
+	if (!queue)
+		return;
+
+	while ((block = block_queue_pop(queue)) != NULL)
+		block_destroy(block);
+
+	free(queue->cells);
+	free(queue);
+}
+
+
+
+/**
+ * block_queue_push - program that submits a block to a queue
+ *
+ * this can be called from any number of threads at once, and never blocks
+ *
+ * @queue: a pointer to the queue
+ * @block: a pointer to the block to submit; the queue takes ownership of
+ *         it on success
+ *
+ * Return: 0 on success, -1 if the queue is full (the caller keeps the
+ *         block)
+ */
+
+int block_queue_push(block_queue_t *queue, block_t *block)
+{
+	block_queue_cell_t *cell;
+	size_t pos;
+	ptrdiff_t diff;
+
+	if (!queue || !block)
+		return (-1);
+
+	pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+	for (;;)
+	{
+		cell = &queue->cells[pos & queue->mask];
+		diff = (ptrdiff_t)(atomic_load_explicit(&cell->seq,
+							memory_order_acquire) - pos);
+		if (diff == 0)
+		{
+			if (atomic_compare_exchange_weak_explicit(&queue->head,
+				&pos, pos + 1, memory_order_relaxed,
+				memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0)
+			return (-1);
+		else
+			pos = atomic_load_explicit(&queue->head,
+						   memory_order_relaxed);
+	}
+
+	cell->block = block;
+	atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+
+	return (0);
+}
+
+
+
+/**
+ * block_queue_pop - program that takes the oldest block out of a queue
+ *
+ * this must only be called by the single consumer of the queue
+ *
+ * @queue: a pointer to the queue
+ *
+ * Return: a pointer to the block, now owned by the caller, or NULL if the
+ *         queue is empty
+ */
+
+block_t *block_queue_pop(block_queue_t *queue)
+{
+	block_queue_cell_t *cell;
+	block_t *block;
+
+	if (!queue)
+		return (NULL);
+
+	cell = &queue->cells[queue->tail & queue->mask];
+	if (atomic_load_explicit(&cell->seq, memory_order_acquire) !=
+	    queue->tail + 1)
+		return (NULL);
+
+	block = cell->block;
+	atomic_store_explicit(&cell->seq, queue->tail + queue->mask + 1,
+			      memory_order_release);
+	queue->tail++;
+
+	return (block);
+}
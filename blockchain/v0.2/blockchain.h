@@ -8,8 +8,17 @@
 #include <string.h>
 #include <stdint.h>
 #include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <pthread.h>
 #include <openssl/sha.h>
+#include <zlib.h>
 #include "./provided/endianness.h"
+#include "../../crypto/hblk_stats.h"
+#include "../../crypto/hblk_hist.h"
+#include "../../crypto/hblk_trace.h"
 
 
 
@@ -22,6 +31,132 @@
 #define DIFFICULTY_ADJUSTMENT_INTERVAL 5
 
 
+#define HBLK_MAG "HBLK"
+#define HBLK_VER "1.0"
+
+/* Format revision adding a CRC32C after the header and after each record */
+#define HBLK_VER_CRC "1.1"
+
+/* Flags of blockchain_serialize_flags() and blockchain_deserialize_flags() */
+#define HBLK_CRC32C (1 << 0) /* Per-record CRC32C (format revision 1.1) */
+#define HBLK_VERIFY (1 << 1) /* Recompute the hash of every loaded Block */
+#define HBLK_DURABLE (1 << 2) /* Write to a temporary file, fsync, rename */
+#define HBLK_ZLIB (1 << 3) /* Deflate payloads */
+#define HBLK_DEDUP (1 << 4) /* Store duplicate payloads once */
+/* Set by the writer when pruned Blocks are written header-only */
+#define HBLK_PRUNED (1 << 5)
+
+/*
+ * Format revision "1.N" of a file written with a set of flags: N is the sum
+ * of 1 with HBLK_CRC32C, 2 with HBLK_ZLIB, 4 with HBLK_DEDUP and 8 with
+ * HBLK_PRUNED (stored as '0' + N, so past '9' from 10 on)
+ */
+#define HBLK_REV_CRC32C 1
+#define HBLK_REV_ZLIB 2
+#define HBLK_REV_DEDUP 4
+#define HBLK_REV_PRUNED 8
+
+/* Payloads shorter than this are always stored raw */
+#define HBLK_Z_MIN 64
+/* Set in the stored length of a compressed payload */
+#define HBLK_Z_BIT (1U << 31)
+/* Deflate level: favour write speed, chain data compresses well anyway */
+#define HBLK_Z_LEVEL 1
+/* Deflate window (1 KiB, a whole payload) and hash table (2^11 entries) */
+#define HBLK_Z_WBITS 10
+#define HBLK_Z_MEMLEVEL 4
+
+/*
+ * Set in the stored length of a duplicate payload, stored as the position
+ * of the first Block of the file that carries it
+ */
+#define HBLK_REF_BIT (1U << 30)
+/*
+ * Set in the stored length of a header-only record, whose payload was
+ * pruned; such records only follow the Genesis Block or each other, in
+ * files whose revision has HBLK_REV_PRUNED
+ */
+#define HBLK_PRUNED_BIT (1U << 29)
+/* Bits of the stored length of a payload that aren't part of its length */
+#define HBLK_LEN_FLAGS (HBLK_Z_BIT | HBLK_REF_BIT | HBLK_PRUNED_BIT)
+
+/* Payloads shorter than this are never deduplicated */
+#define HBLK_DEDUP_MIN 32
+/* Initial number of entries of a timestamp index */
+#define TIME_INDEX_MIN_ENTRIES 64
+
+/* Initial number of slots of a payload store */
+#define PAYLOAD_STORE_MIN_SLOTS 64
+
+/* Journal of appended Blocks */
+#define HBLJ_MAG "HBLJ"
+#define HBLJ_VER "1.0"
+#define HBLJ_HEADER_SIZE (sizeof(HBLJ_MAG) - 1 + sizeof(HBLJ_VER) - 1 + 1)
+
+/* Segmented storage: manifest and segment files of a store directory */
+#define HBLM_MAG "HBLM"
+#define HBLM_VER "1.0"
+#define HBLK_MANIFEST "%s/MANIFEST"
+#define HBLK_SEGMENT "%s/seg-%06u.hblk"
+
+/* Payload size distributions of the chain generator */
+#define HBLK_GEN_UNIFORM 0 /* Uniform between data_min and data_max */
+#define HBLK_GEN_SKEWED 1 /* Mostly close to data_min, with a long tail */
+/* Difficulty profiles of the chain generator */
+#define HBLK_GEN_FLAT 0 /* Every Block at the initial difficulty */
+#define HBLK_GEN_RAMP 1 /* One more every ramp Blocks */
+#define HBLK_GEN_ADJUST 2 /* Adjusted as blockchain_difficulty() does */
+/* Number of distinct payloads the generator repeats */
+#define HBLK_GEN_POOL 64
+
+/* Formats of blockchain_dump() */
+#define HBLK_DUMP_TEXT 0 /* Same output as _blockchain_print_brief() */
+#define HBLK_DUMP_JSON 1 /* One JSON object per Block, payload in hex */
+#define HBLK_DUMP_CSV 2 /* A header line, then one row per Block */
+/* Size of the output buffer of blockchain_dump() */
+#define HBLK_DUMP_BUFSIZE (1 << 20)
+/* Upper bound of the size of a formatted Block, hex payload included */
+#define HBLK_DUMP_RECORD_MAX (2 * BLOCKCHAIN_DATA_MAX + 512)
+
+/* Columnar export of the Block headers, for analytics */
+#define HBLC_MAG "HBLC"
+#define HBLC_VER "1.0"
+/* Alignment of the header and of every column of a columnar export */
+#define HBLC_ALIGN 64
+#define HBLC_ALIGNED(n) (((size_t)(n) + HBLC_ALIGN - 1) & \
+			 ~(size_t)(HBLC_ALIGN - 1))
+
+/* Size of a .hblk record, without its data buffer and CRC32C */
+#define HBLK_RECORD_SIZE (sizeof(block_info_t) + sizeof(uint32_t) + \
+			  SHA256_DIGEST_LENGTH)
+
+/* Number of Blocks loaded (and byte-swapped) at once */
+#define HBLK_LOAD_BATCH 256
+
+/* Size of the stdio buffer used to read or write a .hblk file */
+#define HBLK_IO_BUFSIZE (1 << 20)
+
+/* Number of Blocks written between two progress reports */
+#define HBLK_PROGRESS_STEP 4096
+
+
+#define GENESIS_BLOCK { \
+	{ /* info */ \
+		0 /* index */, \
+		0, /* difficulty */ \
+		1537578000, /* timestamp */ \
+		0, /* nonce */ \
+		{0} /* prev_hash */ \
+	}, \
+	{ /* data */ \
+		"Holberton School", /* buffer */ \
+		16 /* len */ \
+	}, /* hashed data */\
+	"\xc5\x2c\x26\xc8\xb5\x46\x16\x39\x63\x5d\x8e\xdf\x2a\x97\xd4\x8d" \
+	"\x0c\x8e\x00\x09\xc8\x17\xf2\xb1\xd3\xd7\xff\x2f\x04\x51\x58\x03" \
+}
+
+
 
 /**
  * struct block_info_s - Block info structure
@@ -74,15 +209,670 @@ typedef struct block_data_s
 
 
 
+/* Initial number of slots of a block index (must be a power of 2) */
+#define BLOCK_INDEX_MIN_SLOTS 64
+
+/* Slot key of a block hash: its 4 trailing bytes */
+#define BLOCK_INDEX_KEY(h) ((uint32_t)(h)[28] | (uint32_t)(h)[29] << 8 | \
+			    (uint32_t)(h)[30] << 16 | (uint32_t)(h)[31] << 24)
+
+
+
+/* Work of a Block of a given difficulty, saturated on 64 bits */
+#define BLOCK_WORK(d) ((d) >= 64 ? UINT64_MAX : (uint64_t)1 << (d))
+
+
+
+/**
+ * struct block_node_s - Node of the Block tree
+ *
+ * @block:  Pointer to the Block
+ * @parent: Node of the Block referenced by the Block's info.prev_hash,
+ *          NULL for the Genesis Block
+ * @work:   Cumulative work from the Genesis Block up to this Block
+ *          (sum of BLOCK_WORK(info.difficulty)), saturated on 64 bits
+ * @active: 1 if the Block belongs to the active chain, 0 if it sits on a
+ *          side branch
+ */
+
+typedef struct block_node_s
+{
+    struct block_s  *block;
+    struct block_node_s *parent;
+    uint64_t    work;
+    int     active;
+} block_node_t;
+
+
+
+/**
+ * struct block_index_s - Open-addressing hash table of Block tree nodes
+ *
+ * @slots:    Array of @capacity pointers to block_node_t, NULL when free
+ * @capacity: Number of slots (always a power of 2)
+ * @count:    Number of blocks stored in the table
+ *
+ * Description: Blocks are keyed on their 32-byte hash. A SHA-256 digest is
+ * already uniformly distributed, so its trailing bytes are used directly
+ * as the slot number (the leading bytes are biased towards 0 by the proof
+ * of work). Collisions are resolved by linear probing, and the table is
+ * grown so that it is never more than half full.
+ * Every known Block has a node, whether it is on the active chain or on a
+ * side branch; the index owns the Blocks of the side branches.
+ */
+
+typedef struct block_index_s
+{
+    block_node_t    **slots;
+    uint32_t    capacity;
+    uint32_t    count;
+} block_index_t;
+
+
+
+/* Maximum number of reader threads of a chain view */
+#define CHAIN_VIEW_READERS_MAX 64
+
+
+
+/**
+ * struct chain_array_s - Published array of the Blocks of the active chain
+ *
+ * @size:     Number of Blocks published in @blocks
+ * @capacity: Number of Blocks @blocks can hold
+ * @epoch:    Epoch at which the array was retired
+ * @retired:  Next array in the list of retired arrays
+ * @blocks:   Pointers to the Blocks, from the Genesis Block to the tip
+ */
+
+typedef struct chain_array_s
+{
+    _Atomic uint32_t    size;
+    uint32_t    capacity;
+    uint64_t    epoch;
+    struct chain_array_s    *retired;
+    struct block_s  *blocks[];
+} chain_array_t;
+
+
+
+/**
+ * struct chain_view_s - Lock-free view of the active chain
+ *
+ * @array:   Currently published array
+ * @epoch:   Global epoch, bumped each time an array is retired
+ * @readers: Epoch at which each registered reader took its snapshot,
+ *           0 while it holds none
+ * @nreaders: Number of registered readers
+ * @retired: Arrays replaced by a newer one, waiting for their readers
+ * @stale:   1 if an append failed, so the whole chain must be published
+ *
+ * Description: A single writer appends Blocks while any number of readers
+ * iterate a consistent snapshot of the chain without taking any lock.
+ * Appending stores the Block past the end of the array, then publishes the
+ * new size; a reader never looks past the size it read. When the array is
+ * full, or when a reorganization rewrites its end, a new array is published
+ * and the old one is retired: it is freed once every reader that may have
+ * seen it has released its snapshot (epoch-based reclamation).
+ */
+
+typedef struct chain_view_s
+{
+    chain_array_t * _Atomic array;
+    _Atomic uint64_t    epoch;
+    _Atomic uint64_t    readers[CHAIN_VIEW_READERS_MAX];
+    _Atomic int     nreaders;
+    chain_array_t   *retired;
+    int     stale;
+} chain_view_t;
+
+
+
+/**
+ * struct chain_snapshot_s - Consistent snapshot of the active chain
+ *
+ * @blocks: Pointers to the Blocks, from the Genesis Block to the tip
+ * @size:   Number of Blocks in @blocks
+ */
+
+typedef struct chain_snapshot_s
+{
+    struct block_s * const  *blocks;
+    uint32_t    size;
+} chain_snapshot_t;
+
+
+
+/* Number of Blocks ahead of a chain cursor to prefetch */
+#define CHAIN_CURSOR_PREFETCH 8
+
+/* Number of Blocks per batch when iterating a chain cursor */
+#define CHAIN_CURSOR_BATCH 64
+
+
+
+/**
+ * struct chain_cursor_s - Cursor over the Blocks of the active chain
+ *
+ * @blocks: Pointers to the Blocks, from the Genesis Block to the tip
+ * @size:   Number of Blocks in @blocks
+ * @pos:    Position of the next Block to yield
+ * @array:  Copy of the chain owned by the cursor, NULL when @blocks is
+ *          borrowed from the chain view
+ * @pruned: Index of the last Block whose payload was discarded, 0 if none
+ *
+ * Description: The cursor yields the Blocks one at a time, or in batches
+ * of pointers, so the caller iterates in a plain loop the compiler can
+ * optimize, instead of going through a callback for every node. Blocks a
+ * few positions ahead are prefetched while the current ones are processed.
+ */
+
+typedef struct chain_cursor_s
+{
+    struct block_s * const  *blocks;
+    uint32_t    size;
+    uint32_t    pos;
+    chain_array_t   *array;
+    uint32_t    pruned;
+} chain_cursor_t;
+
+
+
+/**
+ * struct block_queue_cell_s - Cell of a block submission queue
+ *
+ * @seq:   Sequence number, telling whether the cell is free or holds a Block
+ * @block: Pointer to the queued Block
+ */
+
+typedef struct block_queue_cell_s
+{
+    _Atomic size_t  seq;
+    struct block_s  *block;
+} block_queue_cell_t;
+
+
+
+/**
+ * struct block_queue_s - Bounded lock-free multi-producer single-consumer
+ * queue of Blocks
+ *
+ * @cells: Array of @mask + 1 cells
+ * @mask:  Number of cells minus 1 (the number of cells is a power of 2)
+ * @head:  Position of the next push, shared by the producers
+ * @tail:  Position of the next pop, owned by the consumer
+ *
+ * Description: Mining threads push solved Blocks without ever blocking
+ * (a push on a full queue fails right away), and a single appender thread
+ * pops them. Each cell carries a sequence number: a producer claims a
+ * position with a compare-and-swap on @head, fills the cell, then publishes
+ * it by bumping its sequence number. @head and @tail sit on separate cache
+ * lines so producers and the consumer don't false-share.
+ */
+
+typedef struct block_queue_s
+{
+    block_queue_cell_t  *cells;
+    size_t      mask;
+    _Alignas(64) _Atomic size_t head;
+    _Alignas(64) size_t tail;
+} block_queue_t;
+
+
+
+/**
+ * struct payload_s - Entry of a payload store
+ *
+ * @hash:  SHA-256 digest of the payload
+ * @len:   Length of the payload (in bytes)
+ * @refs:  Number of Blocks carrying the payload
+ * @first: Position of the first Block carrying the payload
+ */
+
+typedef struct payload_s
+{
+    uint8_t     hash[SHA256_DIGEST_LENGTH];
+    uint32_t    len;
+    uint32_t    refs;
+    uint32_t    first;
+} payload_t;
+
+
+
+/**
+ * struct payload_store_s - Content-addressed index of Block payloads
+ *
+ * @slots:        Array of @capacity pointers to payload_t, NULL when free
+ * @capacity:     Number of slots (always a power of 2)
+ * @count:        Number of distinct payloads
+ * @refs:         Number of references to the payloads
+ * @bytes:        Total length of the referenced payloads
+ * @unique_bytes: Total length of the distinct payloads
+ *
+ * Description: Payloads are keyed on their SHA-256 digest, in a hash table
+ * laid out like the block index (linear probing, never more than half
+ * full), and reference counted. Only the digest of a payload is kept,
+ * never the payload itself: the index tells the HBLK_DEDUP writer which
+ * earlier Block already carries a payload, and how much it would save.
+ */
+
+typedef struct payload_store_s
+{
+    payload_t   **slots;
+    uint32_t    capacity;
+    uint32_t    count;
+    uint32_t    refs;
+    uint64_t    bytes;
+    uint64_t    unique_bytes;
+} payload_store_t;
+
+
+
+/**
+ * struct hblk_reader_s - State of a .hblk file being loaded
+ *
+ * @file:       File being read
+ * @swap:       1 if the file was written with a different endianness
+ * @flags:      HBLK_CRC32C if the file carries CRCs, HBLK_ZLIB if it
+ *              has compressed payloads, HBLK_DEDUP if it has deduplicated
+ *              payloads, HBLK_VERIFY if the hash of every Block must be
+ *              recomputed
+ * @num_blocks: Number of Blocks in the file
+ * @zstream:    Inflate stream of compressed payloads, reused for every
+ *              record (NULL without HBLK_ZLIB)
+ * @loaded:     The Blocks read so far, by position, so references to
+ *              duplicate payloads can be resolved (NULL without HBLK_DEDUP)
+ * @capacity:   Number of Blocks @loaded has room for; it is doubled as
+ *              Blocks are read, never sized from @num_blocks
+ * @pos:        Position of the next Block to read
+ * @pruned:     Position of the last header-only record read, 0 if none
+ */
+
+typedef struct hblk_reader_s
+{
+    FILE    *file;
+    int     swap;
+    unsigned int    flags;
+    uint32_t    num_blocks;
+    z_stream    *zstream;
+    struct block_s  **loaded;
+    uint32_t    capacity;
+    uint32_t    pos;
+    uint32_t    pruned;
+} hblk_reader_t;
+
+
+
+/**
+ * hblk_progress_t - Progress callback of a .hblk file being written
+ *
+ * @written: Number of Blocks written so far
+ * @total:   Number of Blocks to write
+ * @arg:     Caller argument
+ */
+
+typedef void (*hblk_progress_t)(uint32_t written, uint32_t total, void *arg);
+
+
+
+/**
+ * struct hblk_writer_s - State of a .hblk file being written
+ *
+ * @file:     File being written
+ * @flags:    Serialization flags
+ * @zstream:  Deflate stream of the payloads, reused for every record (NULL
+ *            without HBLK_ZLIB)
+ * @payloads: Payloads written so far (NULL without HBLK_DEDUP)
+ * @progress: Called every HBLK_PROGRESS_STEP Blocks and once all of them
+ *            are written, may be NULL
+ * @arg:      Argument passed to @progress
+ */
+
+typedef struct hblk_writer_s
+{
+    FILE    *file;
+    unsigned int    flags;
+    z_stream    *zstream;
+    struct payload_store_s  *payloads;
+    hblk_progress_t progress;
+    void    *arg;
+} hblk_writer_t;
+
+
+
+/**
+ * struct hblk_journal_s - Journal of the Blocks appended to a Blockchain
+ *
+ * @fd:          File descriptor of the journal, opened in append mode
+ * @pending:     Number of records written since the last fsync
+ * @max_pending: Number of pending records triggering an fsync: 1 to sync
+ *               every record, 0 to only sync on hblk_journal_sync()
+ * @max_delay:   Latency budget: maximum time (in nanoseconds) a written
+ *               record may stay pending, 0 for no budget
+ * @oldest:      Time at which the oldest pending record was written
+ * @syncs:       Number of fsyncs done
+ *
+ * Description: Each appended Block is written as a .hblk record followed
+ * by its CRC32C, with a single write. Instead of an fsync per Block, the
+ * fsyncs are batched (group commit): one fsync makes every pending record
+ * durable, once @max_pending records are pending or the oldest one has
+ * waited for @max_delay. A record torn by a crash fails its CRC: replay
+ * stops there, and reopening the journal cuts it off before appending.
+ * Once the Blockchain is durably saved, hblk_journal_reset() empties it.
+ */
+
+typedef struct hblk_journal_s
+{
+    int     fd;
+    uint32_t    pending;
+    uint32_t    max_pending;
+    uint64_t    max_delay;
+    struct timespec oldest;
+    uint64_t    syncs;
+} hblk_journal_t;
+
+
+
+/**
+ * struct hblk_segment_s - Memory-mapped segment of a store
+ *
+ * @map:     Mapping of the whole segment file, NULL until first accessed
+ * @size:    Size of the mapping, in bytes
+ * @count:   Number of Blocks in the segment
+ * @offsets: Offset of each Block record in the mapping
+ */
+
+typedef struct hblk_segment_s
+{
+    uint8_t     *map;
+    size_t      size;
+    uint32_t    count;
+    uint32_t    *offsets;
+} hblk_segment_t;
+
+
+
+/**
+ * struct hblk_store_s - Segmented storage of a chain
+ *
+ * @dir:        Path to the directory of the store
+ * @seg_height: Number of Blocks per segment
+ * @nsealed:    Number of sealed segments
+ * @sealed:     Sealed segments, mapped on first access
+ * @active:     Blocks of the active segment
+ * @nactive:    Number of Blocks in @active
+ * @npruned:    Number of leading sealed segments known to be header-only
+ *
+ * Description: The chain is split into segment files of @seg_height
+ * Blocks each (.hblk files with CRCs). Only the active segment, holding
+ * the tip, is ever written; once full, it is sealed: it becomes immutable,
+ * short of being rewritten header-only by hblk_store_prune(), and the
+ * manifest, which holds the number of sealed segments, is updated.
+ * Opening a store only reads the manifest and the active segment; sealed
+ * segments are individually mmapped when a Block of theirs is requested.
+ */
+
+typedef struct hblk_store_s
+{
+    char    *dir;
+    uint32_t    seg_height;
+    uint32_t    nsealed;
+    hblk_segment_t  *sealed;
+    struct block_s  **active;
+    uint32_t    nactive;
+    uint32_t    npruned;
+} hblk_store_t;
+
+
+
+/**
+ * hblk_done_t - Completion callback of a background snapshot
+ *
+ * @status: 0 if the snapshot was written, -1 on failure
+ * @arg:    Caller argument
+ */
+
+typedef void (*hblk_done_t)(int status, void *arg);
+
+
+
+/**
+ * struct hblk_snapshot_s - Snapshot of a chain written in the background
+ *
+ * @thread:   Thread writing the snapshot
+ * @blockchain: Blockchain the snapshot is taken of
+ * @cursor:   Cursor over a private copy of the block pointers of the chain
+ * @path:     Path to the file the snapshot is written to
+ * @flags:    Serialization flags
+ * @progress: Progress callback, may be NULL
+ * @done:     Completion callback, may be NULL
+ * @arg:      Argument passed to @progress and @done
+ * @status:   0 once written, -1 on failure
+ *
+ * Description: Blocks are never modified once appended, and blocks detached
+ * by a reorganization stay in the block tree, so only the pointers to the
+ * Blocks are copied when the snapshot is taken, and the chain can keep
+ * growing while they are written. The only write to an appended Block is
+ * blockchain_prune() clearing its payload, which is refused as long as
+ * the snapshots member of @blockchain counts a snapshot in flight. The
+ * callbacks run on @thread.
+ */
+
+typedef struct hblk_snapshot_s
+{
+    pthread_t   thread;
+    struct blockchain_s *blockchain;
+    chain_cursor_t  cursor;
+    char    *path;
+    unsigned int    flags;
+    hblk_progress_t progress;
+    hblk_done_t done;
+    void    *arg;
+    int     status;
+} hblk_snapshot_t;
+
+
+
+/**
+ * struct hblk_gen_s - Parameters of a synthetic chain
+ *
+ * @count:          Number of Blocks after the Genesis Block
+ * @seed:           Seed of the generator, same seed same chain
+ * @data_min:       Smallest payload, in bytes
+ * @data_max:       Largest payload, in bytes, at most BLOCKCHAIN_DATA_MAX
+ * @data_dist:      HBLK_GEN_UNIFORM or HBLK_GEN_SKEWED
+ * @dup_pct:        Percentage of payloads taken from a pool of
+ *                  HBLK_GEN_POOL recurring ones
+ * @profile:        HBLK_GEN_FLAT, HBLK_GEN_RAMP or HBLK_GEN_ADJUST
+ * @difficulty:     Initial difficulty
+ * @difficulty_max: Highest difficulty, 0 for no limit
+ * @ramp:           Number of Blocks per difficulty step of HBLK_GEN_RAMP
+ * @start:          Timestamp of the first Block, 0 for right after the
+ *                  Genesis Block
+ * @interval:       Mean time between two Blocks, in seconds
+ * @jitter:         Largest deviation from @interval, in seconds
+ * @mine:           Nonzero to mine every Block at its difficulty; when 0,
+ *                  every difficulty is 0, so no Block needs mining, and
+ *                  every hash is still valid
+ */
+
+typedef struct hblk_gen_s
+{
+    uint32_t    count;
+    uint64_t    seed;
+    uint32_t    data_min;
+    uint32_t    data_max;
+    int     data_dist;
+    uint32_t    dup_pct;
+    int     profile;
+    uint32_t    difficulty;
+    uint32_t    difficulty_max;
+    uint32_t    ramp;
+    uint64_t    start;
+    uint32_t    interval;
+    uint32_t    jitter;
+    int     mine;
+} hblk_gen_t;
+
+
+
+/**
+ * struct hblk_gen_state_s - State of the chain generator
+ *
+ * @rng:   State of the pseudo-random number generator
+ * @times: Timestamps of the last DIFFICULTY_ADJUSTMENT_INTERVAL Blocks,
+ *         indexed on their index modulo the interval
+ *
+ * Description: The state is reset whenever the Genesis Block is the
+ * previous Block, so it needs no initialization.
+ */
+
+typedef struct hblk_gen_state_s
+{
+    uint64_t    rng;
+    uint64_t    times[DIFFICULTY_ADJUSTMENT_INTERVAL];
+} hblk_gen_state_t;
+
+
+
+/**
+ * struct hblk_dump_s - State of a chain being dumped
+ *
+ * @buf:    Output buffer of HBLK_DUMP_BUFSIZE bytes
+ * @len:    Number of bytes in @buf
+ * @fd:     File descriptor the output is streamed to
+ * @format: One of HBLK_DUMP_TEXT, HBLK_DUMP_JSON, HBLK_DUMP_CSV
+ */
+
+typedef struct hblk_dump_s
+{
+    char    *buf;
+    size_t  len;
+    int     fd;
+    int     format;
+} hblk_dump_t;
+
+
+
+/**
+ * struct hblk_columns_s - Columnar export of the headers of a chain
+ *
+ * @map:        Mapping of the whole file
+ * @size:       Size of the mapping, in bytes
+ * @count:      Number of Blocks
+ * @index:      Column of the Block indexes
+ * @difficulty: Column of the difficulties
+ * @timestamp:  Column of the timestamps
+ * @nonce:      Column of the nonces
+ * @prev_hash:  Column of the hashes of the previous Blocks
+ * @hash:       Column of the Block hashes
+ * @data_len:   Column of the payload lengths
+ *
+ * Description: A structure of arrays: every field of the Blocks is stored
+ * contiguously, in chain order, in a column aligned on HBLC_ALIGN bytes,
+ * so a scan over a field only reads that field, in plain loops the
+ * compiler vectorizes. Columns are stored in the native byte order.
+ */
+
+typedef struct hblk_columns_s
+{
+    uint8_t     *map;
+    size_t      size;
+    uint32_t    count;
+    uint32_t    *index;
+    uint32_t    *difficulty;
+    uint64_t    *timestamp;
+    uint64_t    *nonce;
+    uint8_t     (*prev_hash)[SHA256_DIGEST_LENGTH];
+    uint8_t     (*hash)[SHA256_DIGEST_LENGTH];
+    uint32_t    *data_len;
+} hblk_columns_t;
+
+
+
+/**
+ * struct hblk_series_s - Aggregates over a window of consecutive Blocks
+ *
+ * @first:      Index of the first Block of the window
+ * @count:      Number of Blocks in the window
+ * @min:        Lowest difficulty
+ * @max:        Highest difficulty
+ * @mean:       Mean difficulty
+ * @block_time: Mean time between two Blocks of the window, in seconds
+ */
+
+typedef struct hblk_series_s
+{
+    uint32_t    first;
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    double      mean;
+    double      block_time;
+} hblk_series_t;
+
+
+
+/**
+ * struct time_entry_s - Entry of a timestamp index
+ *
+ * @timestamp: Timestamp of @block
+ * @block:     Block of the active chain
+ */
+
+typedef struct time_entry_s
+{
+    uint64_t    timestamp;
+    struct block_s  *block;
+} time_entry_t;
+
+
+
+/**
+ * struct time_index_s - Blocks of the active chain sorted by timestamp
+ *
+ * @entries:  Array of @capacity entries, sorted by timestamp, then in
+ *            chain order
+ * @capacity: Number of allocated entries
+ * @count:    Number of Blocks in the index
+ *
+ * Description: Timestamps are near-monotonic along the chain, so appending
+ * a Block almost always appends its entry; a Block older than the last
+ * entry is inserted in place, a short move from the end of the array.
+ * Range queries are two binary searches.
+ */
+
+typedef struct time_index_s
+{
+    time_entry_t    *entries;
+    uint32_t    capacity;
+    uint32_t    count;
+} time_index_t;
+
+
+
 /**
  * struct blockchain_s - Blockchain structure
  *
- * @chain: Linked list of pointers to block_t
+ * @chain:   Linked list of pointers to block_t (active chain)
+ * @by_hash: Block tree: index of all the known Blocks, keyed on their hash
+ * @view:    Lock-free view of @chain for concurrent readers, NULL unless
+ *           enabled with blockchain_view_enable()
+ * @pruned:  Index of the last Block whose payload was discarded, 0 if none
+ *           (see blockchain_prune())
+ * @by_time: Blocks of @chain sorted by timestamp
+ * @snapshots: Number of background snapshots still reading the Blocks
+ *             (see blockchain_snapshot_async())
  */
 
 typedef struct blockchain_s
 {
     llist_t     *chain;
+    block_index_t   by_hash;
+    chain_view_t    *view;
+    uint32_t    pruned;
+    time_index_t    by_time;
+    _Atomic uint32_t    snapshots;
 } blockchain_t;
 
 
@@ -127,9 +917,77 @@ uint8_t *block_hash(block_t const *block,
 /* task 5 */
 int write_block_to_file(llist_node_t node, unsigned int idx, void *arg);
 int blockchain_serialize(blockchain_t const *blockchain, char const *path);
+int blockchain_serialize_flags(blockchain_t const *blockchain,
+			       char const *path, unsigned int flags);
+int hblk_write(char const *path, chain_cursor_t *cursor, unsigned int flags);
+int hblk_write_progress(char const *path, chain_cursor_t *cursor,
+			unsigned int flags, hblk_progress_t progress,
+			void *arg);
+int hblk_write_stream(hblk_writer_t *writer, chain_cursor_t *cursor);
+int hblk_writer_init(hblk_writer_t *writer);
+void hblk_writer_clear(hblk_writer_t *writer);
+void hblk_write_header(hblk_writer_t *writer, uint32_t num_blocks);
+void hblk_write_block(hblk_writer_t *writer, block_t const *block,
+		      uint32_t pos, uint32_t pruned);
+int blockchain_serialize_fd(blockchain_t const *blockchain, int fd,
+			    unsigned int flags);
+hblk_snapshot_t *blockchain_snapshot_async(blockchain_t *blockchain,
+					   char const *path,
+					   unsigned int flags,
+					   hblk_progress_t progress,
+					   hblk_done_t done, void *arg);
+int hblk_snapshot_wait(hblk_snapshot_t *snapshot);
 
 /* task 6 */
 blockchain_t *blockchain_deserialize(char const *path);
+blockchain_t *blockchain_deserialize_flags(char const *path,
+					   unsigned int flags);
+blockchain_t *hblk_read_stream(FILE *file, unsigned int flags);
+blockchain_t *blockchain_deserialize_fd(int fd, unsigned int flags);
+void block_info_swap(block_info_t *infos, size_t n);
+block_t *hblk_read_block(hblk_reader_t *reader, block_info_t *info,
+			 int *suspect);
+int hblk_read_batch(hblk_reader_t *reader, blockchain_t *blockchain,
+		    uint32_t n);
+
+uint32_t crc32c(uint32_t crc, void const *buf, size_t len);
+uint32_t block_crc32c(block_t const *block);
+int hblk_sync_dir(char const *path);
+
+z_stream *hblk_zstream_create(int deflating);
+void hblk_zstream_destroy(z_stream *zstream, int deflating);
+uint32_t hblk_deflate(z_stream *zstream, block_data_t const *data,
+		      uint8_t *out);
+int hblk_inflate(z_stream *zstream, uint8_t const *in, uint32_t len,
+		 block_data_t *data);
+
+hblk_journal_t *hblk_journal_open(char const *path, uint32_t max_pending,
+				  uint32_t max_delay_ms);
+int hblk_journal_append(hblk_journal_t *journal, block_t const *block);
+int hblk_journal_sync(hblk_journal_t *journal);
+int hblk_journal_close(hblk_journal_t *journal);
+int hblk_journal_reset(hblk_journal_t *journal);
+int hblk_journal_replay(blockchain_t *blockchain, char const *path,
+			off_t *end);
+
+
+
+/* segmented storage -------------------------------------------------------------------------------------- */
+
+
+int hblk_segment_map(hblk_segment_t *segment, char const *path);
+void hblk_segment_unmap(hblk_segment_t *segment);
+int hblk_segment_get(hblk_segment_t const *segment, uint32_t pos,
+		     block_t *block);
+
+hblk_store_t *hblk_store_open(char const *dir, uint32_t seg_height);
+int hblk_store_manifest_write(hblk_store_t const *store);
+int hblk_store_close(hblk_store_t *store);
+uint32_t hblk_store_size(hblk_store_t const *store);
+int hblk_store_get(hblk_store_t *store, uint32_t index, block_t *block);
+int hblk_store_append(hblk_store_t *store, block_t const *block);
+int hblk_store_flush(hblk_store_t *store);
+int hblk_store_prune(hblk_store_t *store, uint32_t depth);
 
 /* task 7 */
 
@@ -153,4 +1011,139 @@ uint32_t blockchain_difficulty(blockchain_t const *blockchain);
 
 
 
+/* block index -------------------------------------------------------------------------------------------- */
+
+
+int block_index_init(block_index_t *index);
+void block_index_clear(block_index_t *index);
+block_node_t *block_index_insert(block_index_t *index, block_t *block);
+block_node_t *block_index_find(block_index_t const *index,
+			       uint8_t const hash[SHA256_DIGEST_LENGTH]);
+int block_index_sync(block_index_t *index, llist_t *chain);
+
+int blockchain_add_block(blockchain_t *blockchain, block_t *block);
+block_t *blockchain_get_by_hash(blockchain_t const *blockchain,
+				uint8_t const hash[SHA256_DIGEST_LENGTH]);
+
+
+
+/* timestamp index ---------------------------------------------------------------------------------------- */
+
+
+int time_index_init(time_index_t *index);
+void time_index_clear(time_index_t *index);
+uint32_t time_index_bound(time_index_t const *index, uint64_t timestamp);
+int time_index_add(time_index_t *index, block_t *block);
+int time_index_remove(time_index_t *index, block_t const *block);
+
+time_entry_t const *blockchain_range_by_time(blockchain_t const *blockchain,
+					     uint64_t from, uint64_t to,
+					     uint32_t *count);
+
+
+
+/* block tree --------------------------------------------------------------------------------------------- */
+
+
+block_node_t *blockchain_tip(blockchain_t const *blockchain);
+int blockchain_tree_add(blockchain_t *blockchain, block_t *block);
+int blockchain_reorg(blockchain_t *blockchain, block_node_t *tip);
+int blockchain_truncate(blockchain_t *blockchain, uint32_t size);
+int blockchain_prune(blockchain_t *blockchain, uint32_t depth);
+
+
+
+/* concurrent reads --------------------------------------------------------------------------------------- */
+
+
+chain_array_t *chain_array_build(llist_t *chain, uint32_t capacity);
+chain_view_t *chain_view_create(llist_t *chain);
+void chain_view_destroy(chain_view_t *view);
+int chain_view_reserve(chain_view_t *view);
+int chain_view_append(chain_view_t *view, block_t *block);
+int chain_view_publish(chain_view_t *view, llist_t *chain);
+
+int chain_view_reader(chain_view_t *view);
+int chain_view_snapshot(chain_view_t *view, int reader,
+			chain_snapshot_t *snapshot);
+void chain_view_release(chain_view_t *view, int reader);
+
+int blockchain_view_enable(blockchain_t *blockchain);
+
+
+
+/* chain cursor ------------------------------------------------------------------------------------------- */
+
+
+int chain_cursor_open(chain_cursor_t *cursor, blockchain_t const *blockchain);
+block_t const *chain_cursor_next(chain_cursor_t *cursor);
+uint32_t chain_cursor_batch(chain_cursor_t *cursor, block_t const **batch,
+			    uint32_t n);
+void chain_cursor_close(chain_cursor_t *cursor);
+
+
+
+/* block submission queue --------------------------------------------------------------------------------- */
+
+
+block_queue_t *block_queue_create(size_t capacity);
+void block_queue_destroy(block_queue_t *queue);
+int block_queue_push(block_queue_t *queue, block_t *block);
+block_t *block_queue_pop(block_queue_t *queue);
+
+int blockchain_drain(blockchain_t *blockchain, block_queue_t *queue);
+
+
+
+/* chain generator ---------------------------------------------------------------------------------------- */
+
+
+void hblk_gen_block(hblk_gen_t const *gen, hblk_gen_state_t *state,
+		    block_t const *prev, block_t *block);
+blockchain_t *blockchain_generate(hblk_gen_t const *gen);
+int hblk_generate(char const *path, hblk_gen_t const *gen,
+		  unsigned int flags);
+
+
+
+/* bulk dump ---------------------------------------------------------------------------------------------- */
+
+
+char *hblk_fmt_hex(char *out, uint8_t const *buf, size_t len);
+char *hblk_fmt_u64(char *out, uint64_t n);
+char *hblk_fmt_str(char *out, int8_t const *buf, size_t len);
+
+int blockchain_dump(blockchain_t const *blockchain, int fd, int format);
+
+
+
+/* columnar export ---------------------------------------------------------------------------------------- */
+
+
+int blockchain_export_columns(blockchain_t const *blockchain,
+			      char const *path);
+int hblk_columns_map(hblk_columns_t *columns, char const *path);
+void hblk_columns_unmap(hblk_columns_t *columns);
+uint32_t hblk_block_times(hblk_columns_t const *columns, uint64_t *buckets,
+			  uint32_t nbuckets, uint32_t width);
+uint32_t hblk_difficulty_series(hblk_columns_t const *columns,
+				uint32_t window, hblk_series_t *series);
+int hblk_columns_report(char const *path, uint32_t nbuckets, uint32_t width,
+			uint32_t window);
+
+
+
+/* payload deduplication ---------------------------------------------------------------------------------- */
+
+
+payload_store_t *payload_store_create(void);
+void payload_store_destroy(payload_store_t *store);
+payload_t *payload_store_put(payload_store_t *store, int8_t const *data,
+			     uint32_t len, uint32_t first);
+void payload_store_release(payload_store_t *store, payload_t *payload);
+void payload_store_print(payload_store_t const *store);
+payload_store_t *blockchain_payloads(blockchain_t const *blockchain);
+
+
+
 #endif /* BLOCKCHAIN_H */
@@ -0,0 +1,52 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_add_block - program that appends a block to a blockchain
+ *
+ * the block is added at the rear of the active chain and indexed on its
+ * hash, so that it can later be retrieved with blockchain_get_by_hash();
+ * the block's hash must already be computed (see block_hash() and
+ * block_mine()), and the chain takes ownership of the block;
+ * no validation is done here, see blockchain_tree_add() for blocks coming
+ * from the outside;
+ * a block whose hash is already known is rejected up front; if the block
+ * can't be indexed, the chain is truncated back to its former tip rather
+ * than removing the node (see blockchain_truncate());
+ * when concurrent reads are enabled, the block is then published to the
+ * readers of the chain view
+ *
+ * @blockchain: a pointer to the blockchain to append the block to
+ * @block: a pointer to the block to append
+ *
+ * Return: 0 on success, -1 on failure (the block is then not added)
+ */
+
+int blockchain_add_block(blockchain_t *blockchain, block_t *block)
+{
+	uint64_t start = HBLK_STAT_NOW();
+	block_node_t *node;
+
+	if (!blockchain || !block ||
+	    block_index_find(&blockchain->by_hash, block->hash))
+		return (-1);
+
+	if (llist_add_node(blockchain->chain, block, ADD_NODE_REAR) != 0)
+		return (-1);
+
+	node = time_index_add(&blockchain->by_time, block) == 0 ?
+		block_index_insert(&blockchain->by_hash, block) : NULL;
+	if (!node || node->block != block)
+	{
+		time_index_remove(&blockchain->by_time, block);
+		blockchain_truncate(blockchain,
+				    llist_size(blockchain->chain) - 1);
+		return (-1);
+	}
+	node->active = 1;
+
+	if (blockchain->view && chain_view_append(blockchain->view, block) != 0)
+		chain_view_publish(blockchain->view, blockchain->chain);
+	HBLK_LATENCY(HBLK_LAT_BLOCK_APPEND, start);
+
+	return (0);
+}
@@ -1,5 +1,37 @@
 #include "blockchain.h"
 
+/**
+ * genesis_create - program that creates the genesis block
+ *
+ * Return: a pointer to the newly allocated genesis block, or NULL on
+ *         failure
+ */
+
+static block_t *genesis_create(void)
+{
+	block_t *genesis_block;
+	uint8_t genesis_hash[SHA256_DIGEST_LENGTH] = GENESIS_HASH;
+
+	genesis_block = malloc(sizeof(*genesis_block));
+	if (genesis_block == NULL)
+		return (NULL);
+	memset(genesis_block, 0, sizeof(*genesis_block));
+
+	genesis_block->info.index = 0;
+	genesis_block->info.difficulty = 0;
+	genesis_block->info.timestamp = 1537578000;
+	genesis_block->info.nonce = 0;
+	memset(genesis_block->info.prev_hash, 0, SHA256_DIGEST_LENGTH);
+	strncpy((char *)genesis_block->data.buffer, "Holberton School",
+		BLOCKCHAIN_DATA_MAX);
+	genesis_block->data.len = 16;
+	memcpy(genesis_block->hash, genesis_hash, SHA256_DIGEST_LENGTH);
+
+	return (genesis_block);
+}
+
+
+
 /**
  * blockchain_create - program that initializes and returns a new blockchain
  * instance
@@ -18,7 +50,8 @@
  * - hash: a predetermined hash value represented in GENESIS_HASH
  *
  * the blockchain is implemented as a linked list, using the llist library
- * to manage the list of blocks;
+ * to manage the list of blocks, along with an index of the blocks keyed
+ * on their hash, and an index of the blocks sorted by timestamp;
  *
  * Return: a pointer to the newly created blockchain if successful,
  *         otherwise NULL (on failure, any allocated memory is properly
@@ -29,42 +62,25 @@ blockchain_t *blockchain_create(void)
 {
 	blockchain_t *blockchain;
 	block_t *genesis_block;
-	uint8_t genesis_hash[SHA256_DIGEST_LENGTH] = GENESIS_HASH;
 
-	blockchain = malloc(sizeof(*blockchain));
+	blockchain = calloc(1, sizeof(*blockchain));
 	if (blockchain == NULL)
 		return (NULL);
 
 	blockchain->chain = llist_create(MT_SUPPORT_FALSE);
-	if (blockchain->chain == NULL)
-	{
-		free(blockchain);
-		return (NULL);
-	}
-	genesis_block = malloc(sizeof(*genesis_block));
-	if (genesis_block == NULL)
-	{
-		llist_destroy(blockchain->chain, 1, NULL);
-		free(blockchain);
-		return (NULL);
-	}
-	memset(genesis_block, 0, sizeof(*genesis_block));
-
-	genesis_block->info.index = 0;
-	genesis_block->info.difficulty = 0;
-	genesis_block->info.timestamp = 1537578000;
-	genesis_block->info.nonce = 0;
-	memset(genesis_block->info.prev_hash, 0, SHA256_DIGEST_LENGTH);
-	strncpy((char *)genesis_block->data.buffer, "Holberton School",
-		BLOCKCHAIN_DATA_MAX);
-	genesis_block->data.len = 16;
-	memcpy(genesis_block->hash, genesis_hash, SHA256_DIGEST_LENGTH);
-	if (llist_add_node(blockchain->chain, genesis_block, ADD_NODE_FRONT) != 0)
+	genesis_block = genesis_create();
+	if (blockchain->chain == NULL || genesis_block == NULL ||
+	    block_index_init(&blockchain->by_hash) != 0 ||
+	    time_index_init(&blockchain->by_time) != 0 ||
+	    blockchain_add_block(blockchain, genesis_block) != 0)
 	{
 		free(genesis_block);
-		llist_destroy(blockchain->chain, 1, NULL);
+		block_index_clear(&blockchain->by_hash);
+		time_index_clear(&blockchain->by_time);
+		llist_destroy(blockchain->chain, 0, NULL);
 		free(blockchain);
 		return (NULL);
 	}
+
 	return (blockchain);
 }
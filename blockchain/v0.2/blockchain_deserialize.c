@@ -0,0 +1,196 @@
+#include "blockchain.h"
+
+/**
+ * read_header - program that reads and checks the header of a .hblk file
+ *
+ * every format revision is accepted: its digit tells whether the header
+ * and records are followed by a CRC32C, whether payloads may be
+ * compressed or deduplicated, and whether pruned blocks may be written
+ * header-only (see HBLK_REV_CRC32C)
+ *
+ * @reader: the state of the file being loaded; its swap, flags and
+ *          num_blocks members are set, and its zstream with HBLK_ZLIB
+ *
+ * Return: 0 on success, -1 if the header is truncated or invalid
+ */
+
+static int read_header(hblk_reader_t *reader)
+{
+	uint8_t header[sizeof(HBLK_MAG) - 1 + sizeof(HBLK_VER) - 1 + 1 + 4];
+	uint32_t crc, rev;
+
+	if (fread(header, sizeof(header), 1, reader->file) != 1 ||
+	    memcmp(header, HBLK_MAG, sizeof(HBLK_MAG) - 1) ||
+	    memcmp(header + 4, HBLK_VER, sizeof(HBLK_VER) - 2) ||
+	    (header[7] != 1 && header[7] != 2))
+		return (-1);
+	rev = header[6] - HBLK_VER[2];
+	if (rev > (HBLK_REV_CRC32C | HBLK_REV_ZLIB | HBLK_REV_DEDUP |
+		   HBLK_REV_PRUNED))
+		return (-1);
+	reader->flags |= (rev & HBLK_REV_CRC32C ? HBLK_CRC32C : 0) |
+		(rev & HBLK_REV_ZLIB ? HBLK_ZLIB : 0) |
+		(rev & HBLK_REV_DEDUP ? HBLK_DEDUP : 0) |
+		(rev & HBLK_REV_PRUNED ? HBLK_PRUNED : 0);
+
+	reader->swap = header[7] != _get_endianness();
+	memcpy(&reader->num_blocks, header + 8, sizeof(reader->num_blocks));
+	if (reader->swap)
+		reader->num_blocks = __builtin_bswap32(reader->num_blocks);
+
+	if (reader->flags & HBLK_CRC32C)
+	{
+		if (fread(&crc, sizeof(crc), 1, reader->file) != 1)
+			return (-1);
+		if (reader->swap)
+			crc = __builtin_bswap32(crc);
+		if (crc != crc32c(0, header, sizeof(header)))
+			return (-1);
+	}
+
+	if ((reader->flags & HBLK_ZLIB) &&
+	    !(reader->zstream = hblk_zstream_create(0)))
+		return (-1);
+
+	return (0);
+}
+
+
+
+/**
+ * blockchain_load - program that builds a blockchain from the blocks of
+ * an opened .hblk file
+ *
+ * @reader: the state of the file being loaded, positioned right after
+ *          the header
+ *
+ * Return: a pointer to the loaded blockchain, or NULL on failure
+ */
+
+static blockchain_t *blockchain_load(hblk_reader_t *reader)
+{
+	blockchain_t *blockchain = calloc(1, sizeof(*blockchain));
+	uint32_t i, n;
+
+	if (!blockchain)
+		return (NULL);
+
+	blockchain->chain = llist_create(MT_SUPPORT_FALSE);
+	if (!blockchain->chain || block_index_init(&blockchain->by_hash) != 0 ||
+	    time_index_init(&blockchain->by_time) != 0)
+	{
+		llist_destroy(blockchain->chain, 0, NULL);
+		block_index_clear(&blockchain->by_hash);
+		free(blockchain);
+		return (NULL);
+	}
+
+	for (i = 0; i < reader->num_blocks; i += n)
+	{
+		n = reader->num_blocks - i < HBLK_LOAD_BATCH ?
+			reader->num_blocks - i : HBLK_LOAD_BATCH;
+		if (hblk_read_batch(reader, blockchain, n) != 0)
+		{
+			blockchain_destroy(blockchain);
+			return (NULL);
+		}
+	}
+	blockchain->pruned = reader->pruned;
+
+	return (blockchain);
+}
+
+
+
+/**
+ * hblk_read_stream - program that deserializes a blockchain from an opened
+ * stream
+ *
+ * the stream is read sequentially and never sought, so it can be a pipe
+ * or a socket; see blockchain_deserialize_flags() for the format
+ *
+ * @file: the stream to read the blockchain from, positioned on its header
+ * @flags: 0, or HBLK_VERIFY to recompute the hash of every block
+ *
+ * Return: a pointer to the deserialized blockchain, or NULL if the stream
+ *         is truncated, corrupted or invalid
+ */
+
+blockchain_t *hblk_read_stream(FILE *file, unsigned int flags)
+{
+	uint64_t span = HBLK_TRACE_BEGIN();
+	hblk_reader_t reader;
+	blockchain_t *blockchain;
+
+	memset(&reader, 0, sizeof(reader));
+	reader.flags = flags & HBLK_VERIFY;
+	reader.file = file;
+
+	blockchain = read_header(&reader) == 0 ? blockchain_load(&reader) : NULL;
+	hblk_zstream_destroy(reader.zstream, 0);
+	free(reader.loaded);
+	HBLK_TRACE_END("hblk_read", span);
+
+	return (blockchain);
+}
+
+
+
+/**
+ * blockchain_deserialize - program that deserializes a blockchain from
+ * a file
+ *
+ * @path: the path to the file to load the blockchain from
+ *
+ * Return: a pointer to the deserialized blockchain, or NULL if the file
+ *         cannot be opened, or is truncated or invalid
+ */
+
+blockchain_t *blockchain_deserialize(char const *path)
+{
+	return (blockchain_deserialize_flags(path, 0));
+}
+
+
+
+/**
+ * blockchain_deserialize_flags - program that deserializes a blockchain
+ * from a file, with options
+ *
+ * the file must follow the format written by blockchain_serialize_flags();
+ * if it was written on a machine with a different endianness, the
+ * multi-byte fields are converted to the endianness of ours, by batches
+ * of HBLK_LOAD_BATCH block infos (see block_info_swap());
+ * if it carries CRCs, every record is checked against its CRC32C, and only
+ * the blocks failing it have their hash recomputed;
+ * if it has compressed payloads, they are inflated, and if it has
+ * deduplicated payloads, they are copied from the block first carrying
+ * them; header-only records load as pruned blocks;
+ * every loaded block is indexed on its hash
+ *
+ * @path: the path to the file to load the blockchain from
+ * @flags: 0, or HBLK_VERIFY to recompute the hash of every block
+ *
+ * Return: a pointer to the deserialized blockchain, or NULL if the file
+ *         cannot be opened, or is truncated, corrupted or invalid
+ */
+
+blockchain_t *blockchain_deserialize_flags(char const *path,
+					   unsigned int flags)
+{
+	blockchain_t *blockchain;
+	FILE *file;
+
+	if (!path)
+		return (NULL);
+
+	file = fopen(path, "rb");
+	if (!file)
+		return (NULL);
+	setvbuf(file, NULL, _IOFBF, HBLK_IO_BUFSIZE);
+
+	blockchain = hblk_read_stream(file, flags);
+	fclose(file);
+
+	return (blockchain);
+}
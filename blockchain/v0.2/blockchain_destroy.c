@@ -17,6 +17,9 @@ void blockchain_destroy(blockchain_t *blockchain)
 	}
 
 	llist_destroy(blockchain->chain, 1, NULL);
+	block_index_clear(&blockchain->by_hash);
+	time_index_clear(&blockchain->by_time);
+	chain_view_destroy(blockchain->view);
 
 	free(blockchain);
 }
@@ -0,0 +1,46 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_drain - program that appends the blocks submitted to a queue
+ * to a blockchain
+ *
+ * this is the consumer side of the block submission queue, run by the
+ * single appender thread: every queued block is checked against the tip
+ * of the active chain, then validated and appended;
+ * a block that doesn't build on the current tip is a stale solution (the
+ * tip moved while it was being mined) and is discarded before any hash is
+ * computed; invalid blocks are discarded as well
+ *
+ * @blockchain: a pointer to the blockchain to append the blocks to
+ * @queue: a pointer to the queue to drain
+ *
+ * Return: the number of blocks appended, or -1 on failure
+ */
+
+int blockchain_drain(blockchain_t *blockchain, block_queue_t *queue)
+{
+	block_t *block, *tip;
+	int appended = 0;
+
+	if (!blockchain || !queue)
+		return (-1);
+
+	while ((block = block_queue_pop(queue)) != NULL)
+	{
+		tip = llist_get_tail(blockchain->chain);
+		if (!tip || block->info.index != tip->info.index + 1 ||
+		    memcmp(block->info.prev_hash, tip->hash,
+			   SHA256_DIGEST_LENGTH) ||
+		    !hash_matches_difficulty(block->hash,
+					     block->info.difficulty) ||
+		    block_is_valid(block, tip) != 0 ||
+		    blockchain_add_block(blockchain, block) != 0)
+		{
+			block_destroy(block);
+			continue;
+		}
+		appended++;
+	}
+
+	return (appended);
+}
@@ -0,0 +1,185 @@
+#include "blockchain.h"
+#include <errno.h>
+
+/* Appends a string literal to a buffer, yields a pointer past it */
+#define PUT(out, s) ((char *)memcpy((out), (s), sizeof(s) - 1) + sizeof(s) - 1)
+
+/**
+ * dump_flush - program that writes the buffer of a dump to its file
+ * descriptor
+ *
+ * short writes are resumed, so the descriptor may be a pipe or a socket
+ *
+ * @dump: a pointer to the state of the dump
+ *
+ * Return: 0 on success, -1 if the descriptor cannot be written
+ */
+
+static int dump_flush(hblk_dump_t *dump)
+{
+	size_t off = 0;
+	ssize_t n;
+
+	while (off < dump->len)
+	{
+		n = write(dump->fd, dump->buf + off, dump->len - off);
+		if (n == -1 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return (-1);
+		off += n;
+	}
+	dump->len = 0;
+
+	return (0);
+}
+
+
+
+/**
+ * dump_text - program that formats a block as _block_print_brief() does
+ *
+ * @out: the address at which to format the block
+ * @block: a pointer to the block
+ *
+ * Return: a pointer past the formatted block
+ */
+
+static char *dump_text(char *out, block_t const *block)
+{
+	out = PUT(out, "\t\tBlock: {\n\t\t\tinfo: { ");
+	out = PUT(hblk_fmt_u64(out, block->info.index), ", ");
+	out = PUT(hblk_fmt_u64(out, block->info.difficulty), ", ");
+	out = PUT(hblk_fmt_u64(out, block->info.timestamp), ", ");
+	out = PUT(hblk_fmt_u64(out, block->info.nonce), ", ");
+	out = hblk_fmt_hex(out, block->info.prev_hash, SHA256_DIGEST_LENGTH);
+	out = PUT(out, " },\n\t\t\tdata: { \"");
+	out = hblk_fmt_str(out, block->data.buffer, block->data.len);
+	out = PUT(out, "\", ");
+	out = PUT(hblk_fmt_u64(out, block->data.len), " },\n\t\t\thash: ");
+	out = hblk_fmt_hex(out, block->hash, SHA256_DIGEST_LENGTH);
+
+	return (PUT(out, "\n\t\t}\n"));
+}
+
+
+
+/**
+ * dump_json - program that formats a block as a JSON line
+ *
+ * the payload is written in hex, so no byte of it needs escaping
+ *
+ * @out: the address at which to format the block
+ * @block: a pointer to the block
+ *
+ * Return: a pointer past the formatted block
+ */
+
+static char *dump_json(char *out, block_t const *block)
+{
+	out = PUT(out, "{\"index\":");
+	out = PUT(hblk_fmt_u64(out, block->info.index), ",\"difficulty\":");
+	out = PUT(hblk_fmt_u64(out, block->info.difficulty),
+		  ",\"timestamp\":");
+	out = PUT(hblk_fmt_u64(out, block->info.timestamp), ",\"nonce\":");
+	out = PUT(hblk_fmt_u64(out, block->info.nonce), ",\"prev_hash\":\"");
+	out = hblk_fmt_hex(out, block->info.prev_hash, SHA256_DIGEST_LENGTH);
+	out = PUT(out, "\",\"data\":\"");
+	out = hblk_fmt_hex(out, (uint8_t const *)block->data.buffer,
+			   block->data.len);
+	out = PUT(out, "\",\"data_len\":");
+	out = PUT(hblk_fmt_u64(out, block->data.len), ",\"hash\":\"");
+	out = hblk_fmt_hex(out, block->hash, SHA256_DIGEST_LENGTH);
+
+	return (PUT(out, "\"}\n"));
+}
+
+
+
+/**
+ * dump_csv - program that formats a block as a CSV row
+ *
+ * the fields are those of dump_json(), in the same order
+ *
+ * @out: the address at which to format the block
+ * @block: a pointer to the block
+ *
+ * Return: a pointer past the formatted block
+ */
+
+static char *dump_csv(char *out, block_t const *block)
+{
+	out = PUT(hblk_fmt_u64(out, block->info.index), ",");
+	out = PUT(hblk_fmt_u64(out, block->info.difficulty), ",");
+	out = PUT(hblk_fmt_u64(out, block->info.timestamp), ",");
+	out = PUT(hblk_fmt_u64(out, block->info.nonce), ",");
+	out = hblk_fmt_hex(out, block->info.prev_hash, SHA256_DIGEST_LENGTH);
+	out = PUT(out, ",");
+	out = hblk_fmt_hex(out, (uint8_t const *)block->data.buffer,
+			   block->data.len);
+	out = PUT(hblk_fmt_u64(PUT(out, ","), block->data.len), ",");
+	out = hblk_fmt_hex(out, block->hash, SHA256_DIGEST_LENGTH);
+
+	return (PUT(out, "\n"));
+}
+
+
+
+/**
+ * blockchain_dump - program that dumps the active chain of a blockchain to
+ * a file descriptor
+ *
+ * blocks are formatted without stdio into a buffer of HBLK_DUMP_BUFSIZE
+ * bytes, with a table-based hex encoder, and the buffer is written out
+ * whenever it may not hold another block
+ *
+ * @blockchain: a pointer to the blockchain to dump
+ * @fd: the file descriptor to write to, left open
+ * @format: HBLK_DUMP_TEXT, HBLK_DUMP_JSON or HBLK_DUMP_CSV
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int blockchain_dump(blockchain_t const *blockchain, int fd, int format)
+{
+	hblk_dump_t dump = {NULL, 0, -1, 0};
+	chain_cursor_t cursor;
+	block_t const *block = NULL;
+	char *out;
+	int ret;
+
+	if (!blockchain || fd < 0 || format < HBLK_DUMP_TEXT ||
+	    format > HBLK_DUMP_CSV || chain_cursor_open(&cursor, blockchain))
+		return (-1);
+	dump.buf = malloc(HBLK_DUMP_BUFSIZE);
+	dump.fd = fd;
+	dump.format = format;
+
+	out = dump.buf;
+	if (out && format == HBLK_DUMP_TEXT)
+		out = PUT(hblk_fmt_u64(PUT(out, "Blockchain: {\n\tchain ["),
+				       cursor.size), "]: [\n");
+	else if (out && format == HBLK_DUMP_CSV)
+		out = PUT(out, "index,difficulty,timestamp,nonce,prev_hash,"
+			  "data,data_len,hash\n");
+	while (out && (block = chain_cursor_next(&cursor)) != NULL)
+	{
+		dump.len = out - dump.buf;
+		if (dump.len + HBLK_DUMP_RECORD_MAX > HBLK_DUMP_BUFSIZE &&
+		    dump_flush(&dump) != 0)
+			break;
+		out = dump.buf + dump.len;
+		out = format == HBLK_DUMP_TEXT ? dump_text(out, block) :
+			format == HBLK_DUMP_JSON ? dump_json(out, block) :
+			dump_csv(out, block);
+	}
+	if (out && !block && format == HBLK_DUMP_TEXT)
+		out = PUT(out, "\t]\n}\n");
+	dump.len = out ? (size_t)(out - dump.buf) : 0;
+	ret = !out || block || dump_flush(&dump) ? -1 : 0;
+
+	free(dump.buf);
+	chain_cursor_close(&cursor);
+
+	return (ret);
+}
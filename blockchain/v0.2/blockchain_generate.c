@@ -0,0 +1,129 @@
+#include "blockchain.h"
+
+/**
+ * gen_check - program that checks the parameters of a synthetic chain
+ *
+ * @gen: a pointer to the parameters to check
+ *
+ * Return: 0 if they are valid, -1 otherwise
+ */
+
+static int gen_check(hblk_gen_t const *gen)
+{
+	if (!gen || gen->data_min > gen->data_max ||
+	    gen->data_max > BLOCKCHAIN_DATA_MAX || gen->dup_pct > 100 ||
+	    gen->count == UINT32_MAX)
+		return (-1);
+
+	if (gen->data_dist != HBLK_GEN_UNIFORM &&
+	    gen->data_dist != HBLK_GEN_SKEWED)
+		return (-1);
+
+	if (gen->profile != HBLK_GEN_FLAT && gen->profile != HBLK_GEN_ADJUST &&
+	    (gen->profile != HBLK_GEN_RAMP || !gen->ramp))
+		return (-1);
+
+	return (0);
+}
+
+
+
+/**
+ * blockchain_generate - program that builds a synthetic blockchain
+ *
+ * the blocks are generated with hblk_gen_block() and appended with
+ * blockchain_add_block(), so every index of the chain is built as well
+ *
+ * @gen: a pointer to the parameters of the chain
+ *
+ * Return: a pointer to the new blockchain, or NULL on failure
+ */
+
+blockchain_t *blockchain_generate(hblk_gen_t const *gen)
+{
+	blockchain_t *blockchain;
+	hblk_gen_state_t state;
+	block_t *prev, *block;
+	uint32_t i;
+
+	if (gen_check(gen) != 0)
+		return (NULL);
+
+	blockchain = blockchain_create();
+	if (!blockchain)
+		return (NULL);
+
+	prev = llist_get_head(blockchain->chain);
+	for (i = 0; i < gen->count; i++, prev = block)
+	{
+		block = malloc(sizeof(*block));
+		if (block)
+			hblk_gen_block(gen, &state, prev, block);
+		if (!block || blockchain_add_block(blockchain, block) != 0)
+		{
+			free(block);
+			blockchain_destroy(blockchain);
+			return (NULL);
+		}
+	}
+
+	return (blockchain);
+}
+
+
+
+/**
+ * hblk_generate - program that writes a synthetic blockchain straight to
+ * a .hblk file
+ *
+ * the blocks are written as they are generated, two at a time, so a chain
+ * of any length is generated in constant memory
+ *
+ * @path: the path to the file to write
+ * @gen: a pointer to the parameters of the chain
+ * @flags: 0 for the original format, or any of HBLK_CRC32C, HBLK_ZLIB,
+ *         HBLK_DEDUP
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_generate(char const *path, hblk_gen_t const *gen,
+		  unsigned int flags)
+{
+	hblk_writer_t writer = {NULL, 0, NULL, NULL, NULL, NULL};
+	block_t const genesis = GENESIS_BLOCK;
+	hblk_gen_state_t state;
+	block_t *blocks;
+	uint32_t i;
+	int err;
+
+	if (!path || gen_check(gen) != 0)
+		return (-1);
+
+	blocks = malloc(2 * sizeof(*blocks));
+	writer.file = blocks ? fopen(path, "wb") : NULL;
+	writer.flags = flags & ~HBLK_DURABLE;
+	if (!writer.file || hblk_writer_init(&writer) != 0)
+	{
+		hblk_writer_clear(&writer);
+		if (writer.file)
+			fclose(writer.file);
+		free(blocks);
+		return (-1);
+	}
+	setvbuf(writer.file, NULL, _IOFBF, HBLK_IO_BUFSIZE);
+
+	hblk_write_header(&writer, gen->count + 1);
+	hblk_write_block(&writer, &genesis, 0, 0);
+	for (i = 1; i <= gen->count; i++)
+	{
+		hblk_gen_block(gen, &state, i == 1 ? &genesis : &blocks[i % 2],
+			       &blocks[(i + 1) % 2]);
+		hblk_write_block(&writer, &blocks[(i + 1) % 2], i, 0);
+	}
+	hblk_writer_clear(&writer);
+	err = ferror(writer.file);
+	free(blocks);
+
+	return (fclose(writer.file) != 0 || err ? -1 : 0);
+}
@@ -0,0 +1,29 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_get_by_hash - program that retrieves a block from a blockchain
+ * given its hash
+ *
+ * the lookup goes through the hash index of the blockchain instead of
+ * scanning the chain, so it takes constant time on average; this is what
+ * links an incoming block to its parent through info.prev_hash
+ *
+ * @blockchain: a pointer to the blockchain to search
+ * @hash: the hash of the block to look for
+ *
+ * Return: a pointer to the matching block, or NULL if no block of the
+ *         blockchain has this hash; the block may sit on a side branch
+ */
+
+block_t *blockchain_get_by_hash(blockchain_t const *blockchain,
+				uint8_t const hash[SHA256_DIGEST_LENGTH])
+{
+	block_node_t *node;
+
+	if (!blockchain || !hash)
+		return (NULL);
+
+	node = block_index_find(&blockchain->by_hash, hash);
+
+	return (node ? node->block : NULL);
+}
@@ -0,0 +1,139 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_prune - program that discards the payloads of the blocks of
+ * a blockchain deeper than a given depth
+ *
+ * the info and hash of pruned blocks are kept, so the chain still links,
+ * and the difficulty can still be computed; the Genesis Block is never
+ * pruned; a pruned chain is serialized with header-only records, and
+ * reorganizations reaching below the pruned blocks are rejected;
+ * the payload buffer being part of block_t, the memory of a pruned block
+ * is not released, only its payload is cleared;
+ * this is the only write to appended blocks, so it is refused while a
+ * background snapshot is reading them (wait for it with
+ * hblk_snapshot_wait() and prune again);
+ * with a chain view, this must be called from the writer thread, and
+ * readers must not read the payloads of blocks deeper than @depth
+ *
+ * @blockchain: a pointer to the blockchain to prune
+ * @depth: the number of blocks below the tip whose payloads are kept
+ *
+ * Return: the number of blocks pruned, or -1 on failure or if a snapshot
+ *         of the blockchain is in flight
+ */
+
+int blockchain_prune(blockchain_t *blockchain, uint32_t depth)
+{
+	chain_cursor_t cursor;
+	uint32_t tip, i, pruned;
+	block_t *block;
+
+	if (!blockchain ||
+	    atomic_load_explicit(&blockchain->snapshots,
+				 memory_order_acquire) ||
+	    chain_cursor_open(&cursor, blockchain) != 0)
+		return (-1);
+
+	tip = cursor.size - 1;
+	for (i = blockchain->pruned + 1; tip > depth && i < tip - depth; i++)
+	{
+		block = cursor.blocks[i];
+		memset(block->data.buffer, 0, block->data.len);
+		block->data.len = 0;
+	}
+	chain_cursor_close(&cursor);
+
+	pruned = i - 1 - blockchain->pruned;
+	blockchain->pruned = i - 1;
+
+	return ((int)pruned);
+}
+
+
+
+/**
+ * segment_prune - program that rewrites a sealed segment of a store with
+ * header-only records
+ *
+ * @store: a pointer to the store
+ * @seg: the number of the sealed segment
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+static int segment_prune(hblk_store_t *store, uint32_t seg)
+{
+	hblk_segment_t *segment = &store->sealed[seg];
+	chain_cursor_t cursor;
+	char path[PATH_MAX];
+	block_t *blocks, **ptrs;
+	uint32_t i;
+	int ret = -1;
+
+	snprintf(path, sizeof(path), HBLK_SEGMENT, store->dir, seg);
+	if (!segment->map && hblk_segment_map(segment, path) != 0)
+		return (-1);
+
+	memset(&cursor, 0, sizeof(cursor));
+	blocks = malloc(segment->count * sizeof(*blocks));
+	ptrs = malloc(segment->count * sizeof(*ptrs));
+	for (i = 0; blocks && ptrs && i < segment->count; i++)
+	{
+		ptrs[i] = &blocks[i];
+		if (hblk_segment_get(segment, i, &blocks[i]) != 0)
+			break;
+	}
+	if (blocks && ptrs && i && i == segment->count)
+	{
+		cursor.blocks = (block_t * const *)ptrs;
+		cursor.size = i;
+		cursor.pruned = blocks[i - 1].info.index;
+		hblk_segment_unmap(segment);
+		ret = hblk_write(path, &cursor, HBLK_CRC32C | HBLK_DURABLE);
+	}
+	free(blocks);
+	free(ptrs);
+
+	return (ret);
+}
+
+
+
+/**
+ * hblk_store_prune - program that discards the payloads of the blocks of
+ * a store deeper than a given depth
+ *
+ * sealed segments whose blocks are all deeper than @depth are rewritten
+ * with header-only records, durably, one at a time, so the disk usage of
+ * the store is bounded by the recent window plus a header-only record
+ * (HBLK_RECORD_SIZE and a CRC32C) per block;
+ * segments pruned before the store was opened are rewritten again, as
+ * a no-op, on the first call
+ *
+ * @store: a pointer to the store
+ * @depth: the number of blocks below the tip whose payloads are kept
+ *
+ * Return: the number of segments pruned, or -1 on failure
+ */
+
+int hblk_store_prune(hblk_store_t *store, uint32_t depth)
+{
+	uint32_t tip, last;
+	int pruned = 0;
+
+	if (!store || !hblk_store_size(store))
+		return (-1);
+
+	tip = hblk_store_size(store) - 1;
+	for (; store->npruned < store->nsealed; store->npruned++, pruned++)
+	{
+		last = (store->npruned + 1) * store->seg_height - 1;
+		if (tip <= depth || last >= tip - depth)
+			break;
+		if (segment_prune(store, store->npruned) != 0)
+			return (-1);
+	}
+
+	return (pruned);
+}
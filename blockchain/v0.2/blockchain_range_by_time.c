@@ -0,0 +1,41 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_range_by_time - program that finds the blocks of the active
+ * chain created within a time range
+ *
+ * the range is located with two binary searches in the timestamp index,
+ * in O(log n), and the k matching blocks are then read from the returned
+ * entries; the entries are only valid until the chain is modified
+ *
+ * @blockchain: a pointer to the blockchain
+ * @from: the start of the range (UNIX timestamp, inclusive)
+ * @to: the end of the range (UNIX timestamp, inclusive)
+ * @count: the address at which to store the number of matching blocks
+ *
+ * Return: a pointer to the entries of the matching blocks, sorted by
+ *         timestamp, or NULL if there is none
+ */
+
+time_entry_t const *blockchain_range_by_time(blockchain_t const *blockchain,
+					     uint64_t from, uint64_t to,
+					     uint32_t *count)
+{
+	time_index_t const *index;
+	uint32_t first, last;
+
+	if (count)
+		*count = 0;
+	if (!blockchain || !count || from > to)
+		return (NULL);
+
+	index = &blockchain->by_time;
+	first = time_index_bound(index, from);
+	last = to == UINT64_MAX ? index->count : time_index_bound(index, to + 1);
+	if (first >= last)
+		return (NULL);
+
+	*count = last - first;
+
+	return (&index->entries[first]);
+}
@@ -0,0 +1,178 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_tip - program that retrieves the tree node of the tip of
+ * the active chain
+ *
+ * @blockchain: a pointer to the blockchain
+ *
+ * Return: a pointer to the node of the last block of the active chain,
+ *         or NULL if the chain is empty or its tip is not indexed
+ */
+
+block_node_t *blockchain_tip(blockchain_t const *blockchain)
+{
+	block_t *tail;
+
+	if (!blockchain)
+		return (NULL);
+
+	tail = llist_get_tail(blockchain->chain);
+	if (!tail)
+		return (NULL);
+
+	return (block_index_find(&blockchain->by_hash, tail->hash));
+}
+
+
+
+/**
+ * branch_collect - program that collects the nodes of a side branch
+ *
+ * the branch is walked back from its tip up to the first node that
+ * belongs to the active chain (the fork point)
+ *
+ * @tip: the node at the tip of the side branch
+ * @len: the address at which to store the number of collected nodes
+ *
+ * Return: an array of @len nodes, ordered from @tip down to the child of
+ *         the fork point, or NULL on failure (or if @tip has no fork point)
+ */
+
+static block_node_t **branch_collect(block_node_t *tip, size_t *len)
+{
+	block_node_t *node, **branch;
+	size_t i;
+
+	for (*len = 0, node = tip; node && !node->active; node = node->parent)
+		(*len)++;
+	if (!node || *len == 0)
+		return (NULL);
+
+	branch = malloc(*len * sizeof(*branch));
+	if (!branch)
+		return (NULL);
+
+	for (i = 0, node = tip; i < *len; i++, node = node->parent)
+		branch[i] = node;
+
+	return (branch);
+}
+
+
+
+/**
+ * branch_connect - program that appends the blocks of a branch to the
+ * active chain
+ *
+ * each block is added to the time index before the list, so a block is
+ * never left in the chain without being marked active;
+ * when concurrent reads are enabled and no block was detached from the
+ * active chain, the blocks are also appended to the chain view
+ *
+ * @blockchain: a pointer to the blockchain
+ * @branch: the nodes of the branch, from its tip down to the fork point
+ * @len: the number of nodes in @branch
+ * @publish: the address of a flag, set to 1 if the whole chain must be
+ *           published to the view afterwards
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+static int branch_connect(blockchain_t *blockchain, block_node_t **branch,
+			  size_t len, int *publish)
+{
+	block_t *block;
+	size_t i;
+
+	for (i = len; i > 0; i--)
+	{
+		block = branch[i - 1]->block;
+		if (time_index_add(&blockchain->by_time, block) != 0)
+			return (-1);
+		if (llist_add_node(blockchain->chain, block,
+				   ADD_NODE_REAR) != 0)
+		{
+			time_index_remove(&blockchain->by_time, block);
+			return (-1);
+		}
+		branch[i - 1]->active = 1;
+
+		if (blockchain->view && !*publish &&
+		    chain_view_append(blockchain->view, block) != 0)
+			*publish = 1;
+	}
+
+	return (0);
+}
+
+
+
+/**
+ * blockchain_reorg - program that switches the active chain to another tip
+ *
+ * only the diverging suffix is touched: the blocks of the active chain
+ * above the fork point, found by walking up from the tip, are moved to
+ * a side branch, and the blocks of the new branch are appended in order;
+ * the list is truncated at the fork point in a single pass (see
+ * blockchain_truncate());
+ * every block of the new branch must already be indexed and valid
+ * (see blockchain_tree_add());
+ * readers of the chain view keep iterating their former snapshot, and see
+ * the new chain in their next one
+ *
+ * @blockchain: a pointer to the blockchain to reorganize
+ * @tip: the node of the block to become the tip of the active chain
+ *
+ * Return: 0 on success, -1 on failure; on a failure while connecting the
+ *         new branch, the active chain ends at the last connected block
+ */
+
+int blockchain_reorg(blockchain_t *blockchain, block_node_t *tip)
+{
+	block_node_t **branch, *fork, *node, *top;
+	size_t len;
+	uint32_t depth = 0;
+	int publish = 0, ret;
+
+	if (!blockchain || !tip)
+		return (-1);
+	if (tip->active)
+		return (0);
+
+	branch = branch_collect(tip, &len);
+	if (!branch)
+		return (-1);
+	fork = branch[len - 1]->parent;
+	if (blockchain->pruned &&
+	    (!fork || fork->block->info.index < blockchain->pruned))
+	{
+		free(branch);
+		return (-1);
+	}
+
+	top = blockchain_tip(blockchain);
+	for (node = top; node && node != fork; node = node->parent)
+		depth++;
+	if (!node || blockchain_truncate(blockchain,
+					 llist_size(blockchain->chain) - depth))
+	{
+		free(branch);
+		return (-1);
+	}
+	for (node = top; node != fork; node = node->parent)
+	{
+		node->active = 0;
+		time_index_remove(&blockchain->by_time, node->block);
+		publish = 1;
+	}
+
+	ret = branch_connect(blockchain, branch, len, &publish);
+	free(branch);
+
+	if (blockchain->view && publish &&
+	    chain_view_publish(blockchain->view, blockchain->chain) != 0)
+		return (-1);
+
+	return (ret);
+}
@@ -7,8 +7,8 @@
  * and writes them to the specified file;
  * the components include the block's info, data length, data buffer,
  * and hash;
- * this function is typically called by llist_for_each() when serializing
- * the entire blockchain to a file
+ * this function is called for every block when serializing the entire
+ * blockchain to a file
  *
  * @node: a pointer to the block to write, casted to a generic pointer
  * @idx: the index of the block within the blockchain;
@@ -46,41 +46,76 @@ int write_block_to_file(llist_node_t node, unsigned int idx, void *arg)
  * metadata (magic number, version, endianness, and number of blocks)
  * followed by the serialized data of each block;
  * this serialization includes the block's info, data length, data buffer,
- * and hash;
- * the function uses write_block_to_file() to serialize each block
+ * and hash
  *
  * @blockchain: Aapointer to the blockchain to serialize
  * @path: the file path where the blockchain should be saved
  *
  * Return: 0 on successful serialization, -1 if the file cannot be opened
+ *         or written
  */
 
 int blockchain_serialize(blockchain_t const *blockchain, char const *path)
 {
-	FILE *file;
-	char hblk_magic[] = {'H', 'B', 'L', 'K', '\0'};
-	char hblk_version[] = {'1', '.', '0', '\0'};
-	uint8_t hblk_endian;
-	uint32_t num_blocks;
+	return (blockchain_serialize_flags(blockchain, path, 0));
+}
+
+
+
+/**
+ * blockchain_serialize_flags - program that serializes the blockchain to
+ * a file, with options
+ *
+ * with HBLK_CRC32C, every record is followed by its CRC32C (see
+ * block_crc32c()), so corruption can be detected on load without
+ * recomputing the hash of every block;
+ * with HBLK_ZLIB, payloads are deflated, except short or incompressible
+ * ones which are stored raw;
+ * with HBLK_DEDUP, a payload carried by several blocks is only written
+ * for the first one, and referenced by the others;
+ * with HBLK_DURABLE, the blockchain is written to "<path>.tmp", which is
+ * fsynced then renamed over @path, so a crash leaves either the former or
+ * the new file, never a torn one
+ *
+ * @blockchain: a pointer to the blockchain to serialize
+ * @path: the file path where the blockchain should be saved
+ * @flags: 0 for the original format, or any of HBLK_CRC32C, HBLK_ZLIB,
+ *         HBLK_DEDUP, HBLK_DURABLE
+ *
+ * Return: 0 on successful serialization, -1 if the file cannot be opened
+ *         or written
+ */
 
-	file = fopen(path, "wb");
+int blockchain_serialize_flags(blockchain_t const *blockchain,
+			       char const *path, unsigned int flags)
+{
+	chain_cursor_t cursor;
+	int ret;
 
-	if (file == NULL)
-	{
+	if (!blockchain || !path || chain_cursor_open(&cursor, blockchain) != 0)
 		return (-1);
-	}
 
-	hblk_endian = _get_endianness();
-	num_blocks = llist_size(blockchain->chain);
+	ret = hblk_write(path, &cursor, flags);
+	chain_cursor_close(&cursor);
 
-	fwrite(hblk_magic, sizeof(char), sizeof(hblk_magic) - 1, file);
-	fwrite(hblk_version, sizeof(char), sizeof(hblk_version) - 1, file);
-	fwrite(&hblk_endian, sizeof(hblk_endian), 1, file);
-	fwrite(&num_blocks, sizeof(num_blocks), 1, file);
+	return (ret);
+}
 
-	llist_for_each(blockchain->chain, write_block_to_file, file);
 
-	fclose(file);
 
-	return (0);
+/**
+ * hblk_write - program that writes the blocks yielded by a cursor to
+ * a .hblk file
+ *
+ * @path: the file path where the blocks should be saved
+ * @cursor: a cursor yielding the blocks to write
+ * @flags: 0 for the original format, or any of HBLK_CRC32C, HBLK_ZLIB,
+ *         HBLK_DEDUP, HBLK_DURABLE
+ *
+ * Return: 0 on success, -1 if the file cannot be opened or written
+ */
+
+int hblk_write(char const *path, chain_cursor_t *cursor, unsigned int flags)
+{
+	return (hblk_write_progress(path, cursor, flags, NULL, NULL));
 }
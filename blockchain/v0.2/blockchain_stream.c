@@ -0,0 +1,105 @@
+#include "blockchain.h"
+
+/**
+ * stream_open - program that opens a stream over a duplicate of a file
+ * descriptor
+ *
+ * the descriptor of the caller is left open once the stream is closed
+ *
+ * @fd: the file descriptor
+ * @mode: the mode of the stream, as for fopen()
+ *
+ * Return: the opened stream, or NULL on failure
+ */
+
+static FILE *stream_open(int fd, char const *mode)
+{
+	FILE *file;
+	int dup_fd;
+
+	dup_fd = fd < 0 ? -1 : dup(fd);
+	if (dup_fd == -1)
+		return (NULL);
+
+	file = fdopen(dup_fd, mode);
+	if (!file)
+	{
+		close(dup_fd);
+		return (NULL);
+	}
+	setvbuf(file, NULL, _IOFBF, HBLK_IO_BUFSIZE);
+
+	return (file);
+}
+
+
+
+/**
+ * blockchain_serialize_fd - program that serializes a blockchain to a file
+ * descriptor
+ *
+ * the output is the same .hblk format as blockchain_serialize_flags(),
+ * written sequentially through a HBLK_IO_BUFSIZE buffer, so @fd can be a
+ * pipe or a socket, e.g. the standard output piped to ssh;
+ * HBLK_DURABLE is ignored, as there is no file to rename
+ *
+ * @blockchain: a pointer to the blockchain to serialize
+ * @fd: the file descriptor to write to, left open
+ * @flags: 0 for the original format, or any of HBLK_CRC32C, HBLK_ZLIB,
+ *         HBLK_DEDUP
+ *
+ * Return: 0 on success, -1 if the descriptor cannot be written
+ */
+
+int blockchain_serialize_fd(blockchain_t const *blockchain, int fd,
+			    unsigned int flags)
+{
+	hblk_writer_t writer = {NULL, 0, NULL, NULL, NULL, NULL};
+	chain_cursor_t cursor;
+	int ret;
+
+	if (!blockchain || chain_cursor_open(&cursor, blockchain) != 0)
+		return (-1);
+
+	writer.file = stream_open(fd, "wb");
+	writer.flags = flags & ~HBLK_DURABLE;
+	ret = writer.file ? hblk_write_stream(&writer, &cursor) : -1;
+	chain_cursor_close(&cursor);
+
+	if (writer.file && fclose(writer.file) != 0)
+		ret = -1;
+
+	return (ret);
+}
+
+
+
+/**
+ * blockchain_deserialize_fd - program that deserializes a blockchain from
+ * a file descriptor
+ *
+ * the input is read sequentially, so @fd can be a pipe or a socket;
+ * as it is read through a buffer, bytes following the blockchain on @fd
+ * may be consumed as well
+ *
+ * @fd: the file descriptor to read from, left open
+ * @flags: 0, or HBLK_VERIFY to recompute the hash of every block
+ *
+ * Return: a pointer to the deserialized blockchain, or NULL if the input
+ *         is truncated, corrupted or invalid
+ */
+
+blockchain_t *blockchain_deserialize_fd(int fd, unsigned int flags)
+{
+	blockchain_t *blockchain;
+	FILE *file;
+
+	file = stream_open(fd, "rb");
+	if (!file)
+		return (NULL);
+
+	blockchain = hblk_read_stream(file, flags);
+	fclose(file);
+
+	return (blockchain);
+}
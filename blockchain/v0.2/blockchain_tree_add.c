@@ -0,0 +1,52 @@
+#include "blockchain.h"
+
+/**
+ * blockchain_tree_add - program that adds a block to the block tree of
+ * a blockchain, switching the active chain to the most-work tip
+ *
+ * the block's parent is looked up through info.prev_hash, and the block is
+ * validated against it, so a block competing with one of the active chain
+ * is kept on a side branch instead of being rejected;
+ * when the cumulative work of the new block exceeds the one of the active
+ * tip, the active chain is reorganized to end with it (on a tie, the tip
+ * seen first is kept)
+ *
+ * @blockchain: a pointer to the blockchain to add the block to
+ * @block: a pointer to the block to add, with its hash computed
+ *
+ * Return: 1 if the block is now the tip of the active chain,
+ *         0 if it was stored on a side branch,
+ *         -1 if it is already known, its parent is unknown, it is invalid,
+ *         or on failure: only then is the block not taken by the
+ *         blockchain, and must be freed by the caller;
+ *         -2 if it is the heaviest tip but the active chain could not be
+ *         reorganized onto it: the block is kept in the tree, owned by the
+ *         blockchain, and the active chain is not on the heaviest tip
+ *         until blockchain_reorg() succeeds
+ */
+
+int blockchain_tree_add(blockchain_t *blockchain, block_t *block)
+{
+	block_node_t *parent, *node, *tip;
+
+	if (!blockchain || !block || block->info.index == 0)
+		return (-1);
+
+	if (block_index_find(&blockchain->by_hash, block->hash))
+		return (-1);
+
+	parent = block_index_find(&blockchain->by_hash, block->info.prev_hash);
+	if (!parent || block_is_valid(block, parent->block) != 0 ||
+	    !hash_matches_difficulty(block->hash, block->info.difficulty))
+		return (-1);
+
+	node = block_index_insert(&blockchain->by_hash, block);
+	if (!node)
+		return (-1);
+
+	tip = blockchain_tip(blockchain);
+	if (tip && node->work <= tip->work)
+		return (0);
+
+	return (blockchain_reorg(blockchain, node) == 0 ? 1 : -2);
+}
@@ -0,0 +1,90 @@
+#include "blockchain.h"
+
+/**
+ * struct chain_copy_s - State of a chain being copied
+ *
+ * @list: List the blocks are copied to
+ * @size: Number of blocks to copy
+ * @err:  Set to 1 if a block could not be copied
+ */
+
+struct chain_copy_s
+{
+	llist_t *list;
+	uint32_t size;
+	int err;
+};
+
+
+
+/**
+ * chain_copy - program that copies a single block of a chain to a list
+ *
+ * this function is called by llist_for_each() from blockchain_truncate()
+ *
+ * @node: a pointer to the block to copy
+ * @idx: the position of the block in the chain
+ * @arg: a pointer to the state of the copy
+ *
+ * Return: 0 to continue the iteration, 1 once enough blocks are copied
+ */
+
+static int chain_copy(llist_node_t node, unsigned int idx, void *arg)
+{
+	struct chain_copy_s *copy = (struct chain_copy_s *)arg;
+
+	if (idx >= copy->size)
+		return (1);
+	if (llist_add_node(copy->list, node, ADD_NODE_REAR) != 0)
+	{
+		copy->err = 1;
+		return (1);
+	}
+
+	return (0);
+}
+
+
+
+/**
+ * blockchain_truncate - program that drops the blocks of the active chain
+ * above a given height
+ *
+ * llist_remove_node() leaves the tail of a list dangling when it removes
+ * the last node, so the list is rebuilt with its first @size blocks
+ * instead; the dropped blocks are neither freed nor removed from the
+ * indexes, which is left to the caller
+ *
+ * @blockchain: a pointer to the blockchain
+ * @size: the number of blocks to keep
+ *
+ * Return: 0 on success, -1 on failure (the chain is then left unchanged)
+ */
+
+int blockchain_truncate(blockchain_t *blockchain, uint32_t size)
+{
+	struct chain_copy_s copy;
+
+	if (!blockchain)
+		return (-1);
+	if (size >= (uint32_t)llist_size(blockchain->chain))
+		return (0);
+
+	copy.list = llist_create(MT_SUPPORT_FALSE);
+	copy.size = size;
+	copy.err = 0;
+	if (!copy.list)
+		return (-1);
+
+	llist_for_each(blockchain->chain, chain_copy, &copy);
+	if (copy.err)
+	{
+		llist_destroy(copy.list, 0, NULL);
+		return (-1);
+	}
+
+	llist_destroy(blockchain->chain, 0, NULL);
+	blockchain->chain = copy.list;
+
+	return (0);
+}
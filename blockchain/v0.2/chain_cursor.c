@@ -0,0 +1,123 @@
+#include "blockchain.h"
+
+/**
+ * chain_cursor_open - program that opens a cursor over the active chain
+ * of a blockchain
+ *
+ * when concurrent reads are enabled, the cursor borrows the array of the
+ * chain view; otherwise the block pointers are gathered in a single pass
+ * over the list, so a single walk of the chain is slower through a cursor
+ * than with llist_for_each(), and only gets faster with a chain view;
+ * the chain must not be modified while the cursor is open (reader threads
+ * of a chain view use chain_view_snapshot() instead)
+ *
+ * @cursor: the address of the cursor to open
+ * @blockchain: a pointer to the blockchain to iterate
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int chain_cursor_open(chain_cursor_t *cursor, blockchain_t const *blockchain)
+{
+	chain_array_t *array;
+
+	if (!cursor || !blockchain)
+		return (-1);
+
+	memset(cursor, 0, sizeof(*cursor));
+
+	if (blockchain->view && !blockchain->view->stale)
+	{
+		array = atomic_load(&blockchain->view->array);
+	}
+	else
+	{
+		cursor->array = chain_array_build(blockchain->chain, 0);
+		array = cursor->array;
+		if (!array)
+			return (-1);
+	}
+
+	cursor->blocks = (block_t * const *)array->blocks;
+	cursor->size = atomic_load(&array->size);
+	cursor->pruned = blockchain->pruned;
+
+	return (0);
+}
+
+
+
+/**
+ * chain_cursor_next - program that yields the next block of a cursor
+ *
+ * @cursor: a pointer to the cursor
+ *
+ * Return: a pointer to the next block, or NULL once the tip was yielded
+ */
+
+block_t const *chain_cursor_next(chain_cursor_t *cursor)
+{
+	if (!cursor || cursor->pos >= cursor->size)
+		return (NULL);
+
+	if (cursor->pos + CHAIN_CURSOR_PREFETCH < cursor->size)
+		__builtin_prefetch(cursor->blocks[cursor->pos +
+						  CHAIN_CURSOR_PREFETCH]);
+
+	return (cursor->blocks[cursor->pos++]);
+}
+
+
+
+/**
+ * chain_cursor_batch - program that yields the next blocks of a cursor
+ * by batches
+ *
+ * the blocks of the following batch are prefetched, so they are in cache
+ * by the time the caller is done with the current one
+ *
+ * @cursor: a pointer to the cursor
+ * @batch: an array of at least @n pointers, filled with the next blocks
+ * @n: the maximum number of blocks to yield
+ *
+ * Return: the number of blocks stored in @batch, 0 once the tip was yielded
+ */
+
+uint32_t chain_cursor_batch(chain_cursor_t *cursor, block_t const **batch,
+			    uint32_t n)
+{
+	uint32_t i, count, ahead;
+
+	if (!cursor || !batch || cursor->pos >= cursor->size)
+		return (0);
+
+	count = cursor->size - cursor->pos < n ? cursor->size - cursor->pos : n;
+	for (i = 0; i < count; i++)
+		batch[i] = cursor->blocks[cursor->pos + i];
+	cursor->pos += count;
+
+	ahead = cursor->size - cursor->pos < n ? cursor->size - cursor->pos : n;
+	for (i = 0; i < ahead; i++)
+		__builtin_prefetch(cursor->blocks[cursor->pos + i]);
+
+	return (count);
+}
+
+
+
+/**
+ * chain_cursor_close - program that closes a chain cursor
+ *
+ * @cursor: a pointer to the cursor to close
+ *
+ * Return: nothing (void)
+ */
+
+void chain_cursor_close(chain_cursor_t *cursor)
+{
+	if (!cursor)
+		return;
+
+	free(cursor->array);
+	memset(cursor, 0, sizeof(*cursor));
+}
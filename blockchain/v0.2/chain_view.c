@@ -0,0 +1,120 @@
+#include "blockchain.h"
+
+/**
+ * array_fill - program that stores a single block of a chain in an array
+ *
+ * this function is called by llist_for_each() from chain_array_build()
+ *
+ * @node: a pointer to the block to store
+ * @idx: the position of the block in the chain
+ * @arg: a pointer to the array
+ *
+ * Return: 0 to continue the iteration, 1 once the array is full
+ */
+
+static int array_fill(llist_node_t node, unsigned int idx, void *arg)
+{
+	chain_array_t *array = (chain_array_t *)arg;
+
+	if (idx >= array->capacity)
+		return (1);
+
+	array->blocks[idx] = (block_t *)node;
+	atomic_store_explicit(&array->size, idx + 1, memory_order_relaxed);
+
+	return (0);
+}
+
+
+
+/**
+ * chain_array_build - program that creates an array of the blocks of
+ * a chain
+ *
+ * @chain: the list of blocks to store
+ * @capacity: the minimum number of blocks the array must be able to hold;
+ *            it is rounded up to the next power of 2, leaving room for
+ *            at least one more block than the chain holds
+ *
+ * Return: a pointer to the new array, or NULL on failure
+ */
+
+chain_array_t *chain_array_build(llist_t *chain, uint32_t capacity)
+{
+	chain_array_t *array;
+	uint32_t size = (uint32_t)llist_size(chain), cap = 64;
+
+	while (cap < capacity || cap <= size)
+		cap *= 2;
+
+	array = calloc(1, sizeof(*array) + cap * sizeof(array->blocks[0]));
+	if (!array)
+		return (NULL);
+
+	array->capacity = cap;
+	llist_for_each(chain, array_fill, array);
+
+	return (array);
+}
+
+
+
+/**
+ * chain_view_create - program that creates a lock-free view of a chain
+ *
+ * @chain: the list of blocks of the active chain
+ *
+ * Return: a pointer to the new view, or NULL on failure
+ */
+
+chain_view_t *chain_view_create(llist_t *chain)
+{
+	chain_view_t *view;
+
+	if (!chain)
+		return (NULL);
+
+	view = calloc(1, sizeof(*view));
+	if (!view)
+		return (NULL);
+
+	atomic_init(&view->array, chain_array_build(chain, 0));
+	if (!atomic_load(&view->array))
+	{
+		free(view);
+		return (NULL);
+	}
+	atomic_init(&view->epoch, 1);
+
+	return (view);
+}
+
+
+
+/**
+ * chain_view_destroy - program that frees a chain view
+ *
+ * no reader may hold a snapshot of the view anymore; the blocks are not
+ * freed, they are owned by the chain
+ *
+ * @view: a pointer to the view to free
+ *
+ * Return: nothing (void)
+ */
+
+void chain_view_destroy(chain_view_t *view)
+{
+	chain_array_t *array;
+
+	if (!view)
+		return;
+
+	while (view->retired)
+	{
+		array = view->retired;
+		view->retired = array->retired;
+		free(array);
+	}
+	free(atomic_load(&view->array));
+	free(view);
+}
@@ -0,0 +1,164 @@
+#include "blockchain.h"
+
+/**
+ * chain_view_retire - program that retires a replaced array of a view
+ *
+ * the array is stamped with the current epoch, which is then bumped;
+ * every retired array that no reader can still be reading is freed:
+ * a reader holding a snapshot taken at an epoch lower than or equal to
+ * the one of an array may still be reading it
+ *
+ * @view: a pointer to the view
+ * @old: the array that was just replaced
+ *
+ * Return: nothing (void)
+ */
+
+static void chain_view_retire(chain_view_t *view, chain_array_t *old)
+{
+	chain_array_t **link, *array;
+	uint64_t oldest = UINT64_MAX, epoch;
+	int i, nreaders;
+
+	old->epoch = atomic_fetch_add(&view->epoch, 1);
+	old->retired = view->retired;
+	view->retired = old;
+
+	nreaders = atomic_load(&view->nreaders);
+	for (i = 0; i < nreaders && i < CHAIN_VIEW_READERS_MAX; i++)
+	{
+		epoch = atomic_load(&view->readers[i]);
+		if (epoch && epoch < oldest)
+			oldest = epoch;
+	}
+
+	for (link = &view->retired; *link;)
+	{
+		array = *link;
+		if (array->epoch < oldest)
+		{
+			*link = array->retired;
+			free(array);
+		}
+		else
+			link = &array->retired;
+	}
+}
+
+
+
+/**
+ * chain_view_reserve - program that makes room for one more block in
+ * a view
+ *
+ * when the published array is full, a twice larger copy of it is
+ * published and the old one is retired
+ *
+ * @view: a pointer to the view
+ *
+ * Return: 0 on success, -1 if the new array could not be allocated
+ */
+
+int chain_view_reserve(chain_view_t *view)
+{
+	chain_array_t *array, *grown;
+	uint32_t size;
+
+	if (!view)
+		return (-1);
+
+	array = atomic_load_explicit(&view->array, memory_order_relaxed);
+	size = atomic_load_explicit(&array->size, memory_order_relaxed);
+	if (size < array->capacity)
+		return (0);
+
+	grown = calloc(1, sizeof(*grown) +
+		       2 * array->capacity * sizeof(grown->blocks[0]));
+	if (!grown)
+		return (-1);
+
+	grown->capacity = 2 * array->capacity;
+	memcpy(grown->blocks, array->blocks, size * sizeof(array->blocks[0]));
+	atomic_init(&grown->size, size);
+
+	atomic_store(&view->array, grown);
+	chain_view_retire(view, array);
+
+	return (0);
+}
+
+
+
+/**
+ * chain_view_append - program that publishes a new block at the end of
+ * a view
+ *
+ * the block is stored past the size readers can see, then the new size
+ * is published, so a reader sees either the former or the new chain;
+ * this must only be called by the single writer of the view
+ *
+ * @view: a pointer to the view
+ * @block: a pointer to the block to publish
+ *
+ * Return: 0 on success, -1 on failure; the view is then marked stale, and
+ *         refuses appends until the whole chain is published with
+ *         chain_view_publish()
+ */
+
+int chain_view_append(chain_view_t *view, block_t *block)
+{
+	chain_array_t *array;
+	uint32_t size;
+
+	if (!view || !block)
+		return (-1);
+
+	if (view->stale || chain_view_reserve(view) != 0)
+	{
+		view->stale = 1;
+		return (-1);
+	}
+
+	array = atomic_load_explicit(&view->array, memory_order_relaxed);
+	size = atomic_load_explicit(&array->size, memory_order_relaxed);
+
+	array->blocks[size] = block;
+	atomic_store_explicit(&array->size, size + 1, memory_order_release);
+
+	return (0);
+}
+
+
+
+/**
+ * chain_view_publish - program that publishes a whole new chain in a view
+ *
+ * this is used when the end of the chain is rewritten by a reorganization:
+ * the blocks readers may be iterating can't be overwritten in place, so
+ * a new array is published and the old one is retired
+ *
+ * @view: a pointer to the view
+ * @chain: the list of blocks of the active chain
+ *
+ * Return: 0 on success, -1 if the new array could not be allocated (the view
+ *         is then marked stale)
+ */
+
+int chain_view_publish(chain_view_t *view, llist_t *chain)
+{
+	chain_array_t *array, *old;
+
+	if (!view || !chain)
+		return (-1);
+
+	old = atomic_load_explicit(&view->array, memory_order_relaxed);
+	array = chain_array_build(chain, old->capacity);
+	view->stale = array == NULL;
+	if (!array)
+		return (-1);
+
+	atomic_store(&view->array, array);
+	chain_view_retire(view, old);
+
+	return (0);
+}
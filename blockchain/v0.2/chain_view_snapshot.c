@@ -0,0 +1,112 @@
+#include "blockchain.h"
+
+/**
+ * chain_view_reader - program that registers a reader thread of a view
+ *
+ * each reader thread must register once, and use the returned identifier
+ * with chain_view_snapshot() and chain_view_release()
+ *
+ * @view: a pointer to the view
+ *
+ * Return: the reader identifier, or -1 if CHAIN_VIEW_READERS_MAX readers
+ *         are already registered
+ */
+
+int chain_view_reader(chain_view_t *view)
+{
+	int reader;
+
+	if (!view)
+		return (-1);
+
+	reader = atomic_fetch_add(&view->nreaders, 1);
+	if (reader >= CHAIN_VIEW_READERS_MAX)
+	{
+		atomic_fetch_sub(&view->nreaders, 1);
+		return (-1);
+	}
+
+	return (reader);
+}
+
+
+
+/**
+ * chain_view_snapshot - program that takes a consistent snapshot of
+ * the chain, without taking any lock
+ *
+ * the reader announces the current epoch before loading the array, so the
+ * writer won't free it until chain_view_release() is called;
+ * the blocks of the snapshot must not be modified
+ *
+ * @view: a pointer to the view
+ * @reader: the identifier returned by chain_view_reader()
+ * @snapshot: the address at which to store the snapshot
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int chain_view_snapshot(chain_view_t *view, int reader,
+			chain_snapshot_t *snapshot)
+{
+	chain_array_t *array;
+
+	if (!view || !snapshot || reader < 0 ||
+	    reader >= atomic_load(&view->nreaders))
+		return (-1);
+
+	atomic_store(&view->readers[reader], atomic_load(&view->epoch));
+
+	array = atomic_load(&view->array);
+	snapshot->blocks = (block_t * const *)array->blocks;
+	snapshot->size = atomic_load_explicit(&array->size,
+					      memory_order_acquire);
+
+	return (0);
+}
+
+
+
+/**
+ * chain_view_release - program that releases the snapshot of a reader
+ *
+ * @view: a pointer to the view
+ * @reader: the identifier returned by chain_view_reader()
+ *
+ * Return: nothing (void)
+ */
+
+void chain_view_release(chain_view_t *view, int reader)
+{
+	if (!view || reader < 0 || reader >= CHAIN_VIEW_READERS_MAX)
+		return;
+
+	atomic_store_explicit(&view->readers[reader], 0, memory_order_release);
+}
+
+
+
+/**
+ * blockchain_view_enable - program that enables lock-free concurrent
+ * reads of a blockchain
+ *
+ * once enabled, a single writer thread may keep appending blocks with
+ * blockchain_add_block() or blockchain_tree_add(), while reader threads
+ * iterate snapshots taken with chain_view_snapshot() on blockchain->view;
+ * readers must not access blockchain->chain or the block index
+ *
+ * @blockchain: a pointer to the blockchain
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int blockchain_view_enable(blockchain_t *blockchain)
+{
+	if (!blockchain)
+		return (-1);
+
+	if (!blockchain->view)
+		blockchain->view = chain_view_create(blockchain->chain);
+
+	return (blockchain->view ? 0 : -1);
+}
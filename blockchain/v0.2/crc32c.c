@@ -0,0 +1,171 @@
+#include "blockchain.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <nmmintrin.h>
+#define CRC32C_HW 1
+#endif
+
+/* CRC32C (Castagnoli) polynomial, reversed */
+#define CRC32C_POLY 0x82f63b78
+
+/* loads 4 bytes as a little-endian word, whatever the host byte order */
+#define LE32(p) ((uint32_t)(p)[0] | (uint32_t)(p)[1] << 8 | \
+	(uint32_t)(p)[2] << 16 | (uint32_t)(p)[3] << 24)
+
+static uint32_t crc32c_table[8][256];
+static uint32_t crc32c_sw(uint32_t crc, uint8_t const *p, size_t len);
+static uint32_t (*crc32c_impl)(uint32_t, uint8_t const *, size_t) = crc32c_sw;
+
+/**
+ * crc32c_sw - program that updates a raw CRC32C with slicing-by-8
+ *
+ * eight bytes are folded per iteration through eight lookup tables, so the
+ * dependency chain is one table round per word instead of one per byte
+ *
+ * @crc: the running (inverted) checksum
+ * @p: a pointer to the bytes to checksum
+ * @len: the number of bytes to checksum
+ *
+ * Return: the updated running checksum
+ */
+
+static uint32_t crc32c_sw(uint32_t crc, uint8_t const *p, size_t len)
+{
+	uint32_t hi;
+
+	for (; len >= 8; len -= 8, p += 8)
+	{
+		crc ^= LE32(p);
+		hi = LE32(p + 4);
+		crc = crc32c_table[7][crc & 0xff] ^
+			crc32c_table[6][(crc >> 8) & 0xff] ^
+			crc32c_table[5][(crc >> 16) & 0xff] ^
+			crc32c_table[4][crc >> 24] ^
+			crc32c_table[3][hi & 0xff] ^
+			crc32c_table[2][(hi >> 8) & 0xff] ^
+			crc32c_table[1][(hi >> 16) & 0xff] ^
+			crc32c_table[0][hi >> 24];
+	}
+	for (; len > 0; len--)
+		crc = crc32c_table[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+
+	return (crc);
+}
+
+
+
+#ifdef CRC32C_HW
+/**
+ * crc32c_hw - program that updates a raw CRC32C with the SSE4.2 instruction
+ *
+ * compiled for SSE4.2 whatever the build flags, and only called once
+ * crc32c_init() has checked that the CPU supports it
+ *
+ * @crc: the running (inverted) checksum
+ * @p: a pointer to the bytes to checksum
+ * @len: the number of bytes to checksum
+ *
+ * Return: the updated running checksum
+ */
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_hw(uint32_t crc, uint8_t const *p, size_t len)
+{
+	uint64_t crc64 = crc, word;
+
+	for (; len >= sizeof(word); len -= sizeof(word))
+	{
+		memcpy(&word, p, sizeof(word));
+		crc64 = _mm_crc32_u64(crc64, word);
+		p += sizeof(word);
+	}
+	crc = (uint32_t)crc64;
+	for (; len > 0; len--)
+		crc = _mm_crc32_u8(crc, *p++);
+
+	return (crc);
+}
+#endif
+
+
+
+/**
+ * crc32c_init - program that builds the tables and picks the implementation
+ *
+ * runs once at load time, before main(), so crc32c() never pays for any
+ * lazy initialization; the crc32 instruction is used when the CPU has it,
+ * slicing-by-8 otherwise
+ *
+ * Return: nothing (void)
+ */
+
+__attribute__((constructor))
+static void crc32c_init(void)
+{
+	uint32_t i, j, crc;
+
+	for (i = 0; i < 256; i++)
+	{
+		crc = i;
+		for (j = 0; j < 8; j++)
+			crc = crc & 1 ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+		crc32c_table[0][i] = crc;
+	}
+	for (i = 0; i < 256; i++)
+		for (j = 1; j < 8; j++)
+		{
+			crc = crc32c_table[j - 1][i];
+			crc32c_table[j][i] = (crc >> 8) ^
+				crc32c_table[0][crc & 0xff];
+		}
+#ifdef CRC32C_HW
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("sse4.2"))
+		crc32c_impl = crc32c_hw;
+#endif
+}
+
+
+
+/**
+ * crc32c - program that updates a CRC32C checksum with a buffer
+ *
+ * the implementation is resolved once at load time: the SSE4.2 crc32
+ * instruction when the CPU supports it, so checksumming runs at memory
+ * bandwidth, and slicing-by-8 tables otherwise
+ *
+ * @crc: the checksum of the preceding bytes, 0 to start a new one
+ * @buf: a pointer to the bytes to checksum
+ * @len: the number of bytes to checksum
+ *
+ * Return: the updated checksum
+ */
+
+uint32_t crc32c(uint32_t crc, void const *buf, size_t len)
+{
+	return (~crc32c_impl(~crc, (uint8_t const *)buf, len));
+}
+
+
+
+/**
+ * block_crc32c - program that computes the CRC32C of a block record
+ *
+ * the record is checksummed as it is written in a .hblk file: block info,
+ * data length, data buffer and hash
+ *
+ * @block: a pointer to the block
+ *
+ * Return: the checksum of the record
+ */
+
+uint32_t block_crc32c(block_t const *block)
+{
+	uint32_t crc;
+
+	crc = crc32c(0, &block->info, sizeof(block->info));
+	crc = crc32c(crc, &block->data.len, sizeof(block->data.len));
+	crc = crc32c(crc, block->data.buffer, block->data.len);
+
+	return (crc32c(crc, block->hash, SHA256_DIGEST_LENGTH));
+}
@@ -0,0 +1,208 @@
+#include "blockchain.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * columns_layout - program that lays out the columns of a columnar export
+ *
+ * the header takes HBLC_ALIGN bytes, and every column starts on a multiple
+ * of HBLC_ALIGN bytes
+ *
+ * @columns: a pointer to the columns; their pointers are set if @base is
+ *           not NULL
+ * @base: the address of the file image, or NULL to only compute its size
+ * @count: the number of blocks
+ *
+ * Return: the size of the file image, in bytes
+ */
+
+static size_t columns_layout(hblk_columns_t *columns, uint8_t *base,
+			     uint32_t count)
+{
+	size_t const width[] = {sizeof(uint32_t), sizeof(uint32_t),
+		sizeof(uint64_t), sizeof(uint64_t), SHA256_DIGEST_LENGTH,
+		SHA256_DIGEST_LENGTH, sizeof(uint32_t)};
+	size_t off[sizeof(width) / sizeof(*width)], size = HBLC_ALIGN, i;
+
+	for (i = 0; i < sizeof(width) / sizeof(*width); i++)
+	{
+		off[i] = size;
+		size += HBLC_ALIGNED(width[i] * count);
+	}
+
+	columns->count = count;
+	if (!base)
+		return (size);
+	columns->index = (uint32_t *)(base + off[0]);
+	columns->difficulty = (uint32_t *)(base + off[1]);
+	columns->timestamp = (uint64_t *)(base + off[2]);
+	columns->nonce = (uint64_t *)(base + off[3]);
+	columns->prev_hash = (uint8_t (*)[SHA256_DIGEST_LENGTH])(base + off[4]);
+	columns->hash = (uint8_t (*)[SHA256_DIGEST_LENGTH])(base + off[5]);
+	columns->data_len = (uint32_t *)(base + off[6]);
+
+	return (size);
+}
+
+
+
+/**
+ * columns_fill - program that fills the image of a columnar export
+ *
+ * the header holds the magic number, the format version, the endianness,
+ * the number of blocks and the CRC32C of those 12 bytes
+ *
+ * @columns: a pointer to the columns, laid out over a zeroed image
+ * @cursor: a cursor opened over the blockchain to export
+ *
+ * Return: nothing (void)
+ */
+
+static void columns_fill(hblk_columns_t *columns, chain_cursor_t *cursor)
+{
+	block_t const *batch[CHAIN_CURSOR_BATCH];
+	uint32_t count, i, pos = 0, crc;
+	block_t const *block;
+
+	memcpy(columns->map, HBLC_MAG HBLC_VER, 7);
+	columns->map[7] = _get_endianness();
+	memcpy(columns->map + 8, &columns->count, sizeof(columns->count));
+	crc = crc32c(0, columns->map, 12);
+	memcpy(columns->map + 12, &crc, sizeof(crc));
+
+	while ((count = chain_cursor_batch(cursor, batch,
+					   CHAIN_CURSOR_BATCH)) != 0)
+	{
+		for (i = 0; i < count; i++, pos++)
+		{
+			block = batch[i];
+			columns->index[pos] = block->info.index;
+			columns->difficulty[pos] = block->info.difficulty;
+			columns->timestamp[pos] = block->info.timestamp;
+			columns->nonce[pos] = block->info.nonce;
+			memcpy(columns->prev_hash[pos], block->info.prev_hash,
+			       SHA256_DIGEST_LENGTH);
+			memcpy(columns->hash[pos], block->hash,
+			       SHA256_DIGEST_LENGTH);
+			columns->data_len[pos] = block->data.len;
+		}
+	}
+}
+
+
+
+/**
+ * blockchain_export_columns - program that exports the block headers of
+ * the active chain of a blockchain to a columnar file
+ *
+ * the file is built in memory in a single pass over the chain, then
+ * written at once (see hblk_columns_t for its layout)
+ *
+ * @blockchain: a pointer to the blockchain to export
+ * @path: the path to the file to write
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int blockchain_export_columns(blockchain_t const *blockchain,
+			      char const *path)
+{
+	hblk_columns_t columns;
+	chain_cursor_t cursor;
+	FILE *file = NULL;
+	int ret = -1;
+
+	if (!blockchain || !path || chain_cursor_open(&cursor, blockchain) != 0)
+		return (-1);
+
+	columns.size = columns_layout(&columns, NULL, cursor.size);
+	columns.map = calloc(1, columns.size);
+	if (columns.map)
+		file = fopen(path, "wb");
+	if (file)
+	{
+		columns_layout(&columns, columns.map, cursor.size);
+		columns_fill(&columns, &cursor);
+		ret = fwrite(columns.map, 1, columns.size, file) !=
+			columns.size;
+		ret = fclose(file) != 0 || ret ? -1 : 0;
+		if (ret != 0)
+			remove(path);
+	}
+	free(columns.map);
+	chain_cursor_close(&cursor);
+
+	return (ret);
+}
+
+
+
+/**
+ * hblk_columns_map - program that maps a columnar export in memory
+ *
+ * only the header is read: the columns are paged in as they are scanned
+ *
+ * @columns: a pointer to the columns to map
+ * @path: the path to the columnar file
+ *
+ * Return: 0 on success, -1 if the file cannot be mapped, or is truncated,
+ *         invalid, or of another endianness
+ */
+
+int hblk_columns_map(hblk_columns_t *columns, char const *path)
+{
+	struct stat st;
+	uint8_t *map;
+	uint32_t count, crc;
+	int fd;
+
+	if (!columns || !path)
+		return (-1);
+
+	fd = open(path, O_RDONLY);
+	if (fd == -1)
+		return (-1);
+	if (fstat(fd, &st) != 0 || st.st_size < HBLC_ALIGN)
+	{
+		close(fd);
+		return (-1);
+	}
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return (-1);
+
+	memcpy(&count, map + 8, sizeof(count));
+	memcpy(&crc, map + 12, sizeof(crc));
+	if (memcmp(map, HBLC_MAG HBLC_VER, 7) || map[7] != _get_endianness() ||
+	    crc != crc32c(0, map, 12) ||
+	    columns_layout(columns, map, count) != (size_t)st.st_size)
+	{
+		munmap(map, st.st_size);
+		return (-1);
+	}
+	columns->map = map;
+	columns->size = st.st_size;
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_columns_unmap - program that unmaps a columnar export
+ *
+ * @columns: a pointer to the columns to unmap
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_columns_unmap(hblk_columns_t *columns)
+{
+	if (!columns)
+		return;
+
+	if (columns->map)
+		munmap(columns->map, columns->size);
+	memset(columns, 0, sizeof(*columns));
+}
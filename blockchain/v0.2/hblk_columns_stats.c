@@ -0,0 +1,193 @@
+#include "blockchain.h"
+
+/**
+ * hblk_block_times - program that builds the histogram of the times
+ * between consecutive blocks of a columnar export
+ *
+ * only the timestamp column is read; an interval of t seconds is counted
+ * in bucket t / @width, the last bucket counting every longer interval,
+ * and the first one the intervals of blocks older than their predecessor
+ *
+ * @columns: a pointer to the mapped columns
+ * @buckets: an array of @nbuckets counters, overwritten
+ * @nbuckets: the number of buckets
+ * @width: the width of a bucket, in seconds
+ *
+ * Return: the number of intervals counted, 0 on failure
+ */
+
+uint32_t hblk_block_times(hblk_columns_t const *columns, uint64_t *buckets,
+			  uint32_t nbuckets, uint32_t width)
+{
+	uint64_t const *timestamp;
+	uint64_t bucket, last;
+	uint32_t i;
+
+	if (!columns || !buckets || !nbuckets || !width || columns->count < 2)
+		return (0);
+
+	memset(buckets, 0, nbuckets * sizeof(*buckets));
+	timestamp = columns->timestamp;
+	last = nbuckets - 1;
+	for (i = 1; i < columns->count; i++)
+	{
+		bucket = timestamp[i] > timestamp[i - 1] ?
+			(timestamp[i] - timestamp[i - 1]) / width : 0;
+		buckets[bucket < last ? bucket : last]++;
+	}
+
+	return (columns->count - 1);
+}
+
+
+
+/**
+ * hblk_difficulty_series - program that aggregates the difficulty and
+ * block time of a columnar export over windows of consecutive blocks
+ *
+ * only the index, difficulty and timestamp columns are read, and the
+ * inner loop is a plain reduction the compiler vectorizes
+ *
+ * @columns: a pointer to the mapped columns
+ * @window: the number of blocks per window
+ * @series: an array of at least ceil(count / @window) entries, filled
+ *
+ * Return: the number of windows, 0 on failure
+ */
+
+uint32_t hblk_difficulty_series(hblk_columns_t const *columns,
+				uint32_t window, hblk_series_t *series)
+{
+	uint32_t const *difficulty;
+	uint32_t first, end, i, min, max, n = 0;
+	uint64_t sum;
+
+	if (!columns || !window || !series)
+		return (0);
+
+	difficulty = columns->difficulty;
+	for (first = 0; first < columns->count; first = end, n++)
+	{
+		end = columns->count - first > window ? first + window :
+			columns->count;
+		min = UINT32_MAX;
+		max = 0;
+		sum = 0;
+		for (i = first; i < end; i++)
+		{
+			min = difficulty[i] < min ? difficulty[i] : min;
+			max = difficulty[i] > max ? difficulty[i] : max;
+			sum += difficulty[i];
+		}
+		series[n].first = columns->index[first];
+		series[n].count = end - first;
+		series[n].min = min;
+		series[n].max = max;
+		series[n].mean = (double)sum / (end - first);
+		series[n].block_time = end - first < 2 ? 0. :
+			((double)columns->timestamp[end - 1] -
+			 (double)columns->timestamp[first]) / (end - first - 1);
+	}
+
+	return (n);
+}
+
+
+
+/**
+ * print_block_times - program that prints a histogram of block times
+ *
+ * @buckets: the array of counters
+ * @nbuckets: the number of buckets
+ * @width: the width of a bucket, in seconds
+ * @total: the number of intervals counted
+ *
+ * Return: nothing (void)
+ */
+
+static void print_block_times(uint64_t const *buckets, uint32_t nbuckets,
+			      uint32_t width, uint32_t total)
+{
+	uint32_t i;
+
+	printf("Block times: %u intervals\n", total);
+	for (i = 0; i < nbuckets; i++)
+	{
+		if (i + 1 < nbuckets)
+			printf("  [%6lu, %6lu) s: ", (unsigned long)i * width,
+			       (unsigned long)(i + 1) * width);
+		else
+			printf("  [%6lu,    inf) s: ",
+			       (unsigned long)i * width);
+		printf("%10lu (%5.1f%%)\n", (unsigned long)buckets[i],
+		       total ? 100. * buckets[i] / total : 0.);
+	}
+}
+
+
+
+/**
+ * print_series - program that prints a difficulty series
+ *
+ * @series: the array of windows
+ * @n: the number of windows
+ *
+ * Return: nothing (void)
+ */
+
+static void print_series(hblk_series_t const *series, uint32_t n)
+{
+	uint32_t i;
+
+	printf("Difficulty: %u windows\n", n);
+	for (i = 0; i < n; i++)
+		printf("  #%-10u %8u blocks, difficulty %3u..%-3u mean %6.2f, "
+		       "block time %.2f s\n", series[i].first, series[i].count,
+		       series[i].min, series[i].max, series[i].mean,
+		       series[i].block_time);
+}
+
+
+
+/**
+ * hblk_columns_report - program that prints the block time histogram and
+ * the difficulty series of a columnar export
+ *
+ * @path: the path to the columnar file (see blockchain_export_columns())
+ * @nbuckets: the number of buckets of the histogram
+ * @width: the width of a bucket, in seconds
+ * @window: the number of blocks per window of the difficulty series
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_columns_report(char const *path, uint32_t nbuckets, uint32_t width,
+			uint32_t window)
+{
+	hblk_columns_t columns;
+	hblk_series_t *series = NULL;
+	uint64_t *buckets = NULL;
+	uint32_t total, n;
+	int ret = -1;
+
+	if (!nbuckets || !width || !window ||
+	    hblk_columns_map(&columns, path) != 0)
+		return (-1);
+
+	buckets = malloc(nbuckets * sizeof(*buckets));
+	series = malloc((columns.count / window + 1) * sizeof(*series));
+	if (buckets && series)
+	{
+		printf("Blocks: %u\n", columns.count);
+		total = hblk_block_times(&columns, buckets, nbuckets, width);
+		print_block_times(buckets, nbuckets, width, total);
+		n = hblk_difficulty_series(&columns, window, series);
+		print_series(series, n);
+		ret = 0;
+	}
+	hblk_columns_unmap(&columns);
+	free(buckets);
+	free(series);
+
+	return (ret);
+}
@@ -0,0 +1,85 @@
+#include "blockchain.h"
+
+/* The 16 hex digit pairs starting with a given digit */
+#define HEX_ROW(h) h "0" h "1" h "2" h "3" h "4" h "5" h "6" h "7" \
+	h "8" h "9" h "a" h "b" h "c" h "d" h "e" h "f"
+
+/**
+ * hblk_fmt_hex - program that formats a buffer in its hexadecimal form
+ *
+ * every byte is looked up in a table of the 256 digit pairs, so it costs
+ * a single load and a 2-byte copy, instead of a printf("%02x") call
+ *
+ * @out: the address at which to write the 2 * @len digits, not
+ *       NUL-terminated
+ * @buf: a pointer to the buffer to format
+ * @len: the number of bytes of @buf to format
+ *
+ * Return: a pointer past the last digit written
+ */
+
+char *hblk_fmt_hex(char *out, uint8_t const *buf, size_t len)
+{
+	static char const pairs[] = HEX_ROW("0") HEX_ROW("1") HEX_ROW("2")
+		HEX_ROW("3") HEX_ROW("4") HEX_ROW("5") HEX_ROW("6")
+		HEX_ROW("7") HEX_ROW("8") HEX_ROW("9") HEX_ROW("a")
+		HEX_ROW("b") HEX_ROW("c") HEX_ROW("d") HEX_ROW("e")
+		HEX_ROW("f");
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		memcpy(out + 2 * i, pairs + 2 * buf[i], 2);
+
+	return (out + 2 * len);
+}
+
+
+
+/**
+ * hblk_fmt_u64 - program that formats an unsigned integer in decimal
+ *
+ * @out: the address at which to write the digits, not NUL-terminated
+ * @n: the integer to format
+ *
+ * Return: a pointer past the last digit written
+ */
+
+char *hblk_fmt_u64(char *out, uint64_t n)
+{
+	char digits[20];
+	int len = 0;
+
+	do {
+		digits[len++] = '0' + n % 10;
+		n /= 10;
+	} while (n);
+
+	while (len)
+		*out++ = digits[--len];
+
+	return (out);
+}
+
+
+
+/**
+ * hblk_fmt_str - program that copies a payload up to its first NUL byte,
+ * as printf("%s") would print it
+ *
+ * @out: the address at which to copy the bytes, not NUL-terminated
+ * @buf: a pointer to the payload
+ * @len: the length of the payload
+ *
+ * Return: a pointer past the last byte written
+ */
+
+char *hblk_fmt_str(char *out, int8_t const *buf, size_t len)
+{
+	int8_t const *end = memchr(buf, 0, len);
+
+	if (end)
+		len = end - buf;
+	memcpy(out, buf, len);
+
+	return (out + len);
+}
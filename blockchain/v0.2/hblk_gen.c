@@ -0,0 +1,156 @@
+#include "blockchain.h"
+
+/**
+ * gen_rand - program that draws a pseudo-random number (splitmix64)
+ *
+ * @state: a pointer to the state of the generator, advanced
+ *
+ * Return: the number drawn
+ */
+
+static uint64_t gen_rand(uint64_t *state)
+{
+	uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+	return (z ^ (z >> 31));
+}
+
+
+
+/**
+ * gen_payload - program that generates the payload of a synthetic block
+ *
+ * payloads are lowercase letters; a recurring payload is drawn from a
+ * generator seeded with one of HBLK_GEN_POOL seeds, so it is identical
+ * every time it recurs, without being kept anywhere
+ *
+ * @gen: a pointer to the parameters of the chain
+ * @rng: a pointer to the state of the generator
+ * @buffer: the address at which to write the payload
+ *
+ * Return: the length of the payload
+ */
+
+static uint32_t gen_payload(hblk_gen_t const *gen, uint64_t *rng,
+			    int8_t *buffer)
+{
+	uint64_t pool = gen->seed + 1 + gen_rand(rng) % HBLK_GEN_POOL, word = 0;
+	uint64_t *state = gen_rand(rng) % 100 < gen->dup_pct ? &pool : rng;
+	uint32_t span = gen->data_max - gen->data_min, len, i;
+	double u = (gen_rand(state) >> 11) * (1. / (1ULL << 53));
+
+	if (gen->data_dist == HBLK_GEN_SKEWED)
+		u = u * u * u;
+	len = gen->data_min + (uint32_t)(u * (span + 1));
+	len = len > gen->data_max ? gen->data_max : len;
+
+	for (i = 0; i < len; i++, word >>= 8)
+	{
+		if (i % sizeof(word) == 0)
+			word = gen_rand(state);
+		buffer[i] = 'a' + (word & 0xff) % 26;
+	}
+
+	return (len);
+}
+
+
+
+/**
+ * gen_difficulty - program that computes the difficulty of a synthetic
+ * block according to the profile of the chain
+ *
+ * HBLK_GEN_ADJUST applies the rule of blockchain_difficulty() to the
+ * timestamps kept in the state, instead of walking the chain
+ *
+ * @gen: a pointer to the parameters of the chain
+ * @state: a pointer to the state of the generator
+ * @prev: a pointer to the previous block
+ *
+ * Return: the difficulty of the next block
+ */
+
+static uint32_t gen_difficulty(hblk_gen_t const *gen,
+			       hblk_gen_state_t const *state,
+			       block_t const *prev)
+{
+	uint32_t difficulty = prev->info.difficulty, index = prev->info.index;
+	uint64_t actual, expected;
+
+	if (!gen->mine)
+		return (0);
+
+	if (index == 0)
+		difficulty = gen->difficulty;
+	else if (gen->profile == HBLK_GEN_RAMP)
+		difficulty = gen->difficulty + index / gen->ramp;
+	else if (gen->profile == HBLK_GEN_ADJUST &&
+		 (index + 1) % DIFFICULTY_ADJUSTMENT_INTERVAL == 0)
+	{
+		expected = BLOCK_GENERATION_INTERVAL *
+			DIFFICULTY_ADJUSTMENT_INTERVAL;
+		index = (index + 1) % DIFFICULTY_ADJUSTMENT_INTERVAL;
+		actual = prev->info.timestamp - state->times[index];
+		if (actual < expected / 2)
+			difficulty++;
+		else if (actual > expected * 2 && difficulty > 0)
+			difficulty--;
+	}
+
+	if (gen->difficulty_max && difficulty > gen->difficulty_max)
+		difficulty = gen->difficulty_max;
+
+	return (difficulty);
+}
+
+
+
+/**
+ * hblk_gen_block - program that generates the next block of a synthetic
+ * chain
+ *
+ * the block links to @prev and carries a valid hash: it is mined at its
+ * difficulty with @gen->mine, and simply hashed otherwise, at difficulty 0
+ *
+ * @gen: a pointer to the parameters of the chain
+ * @state: a pointer to the state of the generator, reset if @prev is the
+ *         Genesis Block
+ * @prev: a pointer to the previous block
+ * @block: the address at which to generate the block
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_gen_block(hblk_gen_t const *gen, hblk_gen_state_t *state,
+		    block_t const *prev, block_t *block)
+{
+	uint64_t jitter, i;
+
+	if (prev->info.index == 0)
+	{
+		state->rng = gen->seed;
+		for (i = 0; i < DIFFICULTY_ADJUSTMENT_INTERVAL; i++)
+			state->times[i] = prev->info.timestamp;
+	}
+	jitter = gen->jitter ?
+		gen_rand(&state->rng) % (2ULL * gen->jitter + 1) : 0;
+
+	memset(block, 0, sizeof(*block));
+	block->info.index = prev->info.index + 1;
+	block->info.difficulty = gen_difficulty(gen, state, prev);
+	block->info.timestamp = prev->info.index == 0 && gen->start ?
+		gen->start : prev->info.timestamp + gen->interval + jitter -
+		gen->jitter;
+	memcpy(block->info.prev_hash, prev->hash, SHA256_DIGEST_LENGTH);
+	block->data.len = gen_payload(gen, &state->rng, block->data.buffer);
+	state->times[block->info.index % DIFFICULTY_ADJUSTMENT_INTERVAL] =
+		block->info.timestamp;
+
+	if (block->info.difficulty)
+		block_mine(block);
+	else
+		block_hash(block, block->hash);
+}
@@ -0,0 +1,200 @@
+#include "blockchain.h"
+#include <libgen.h>
+
+/**
+ * hblk_sync_dir - program that flushes the directory entry of a file
+ *
+ * a file created or renamed is only durable once the directory holding
+ * it is fsynced as well
+ *
+ * @path: the path to the file
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_sync_dir(char const *path)
+{
+	char dir[PATH_MAX];
+	int fd, ret;
+
+	if (!path || strlen(path) >= sizeof(dir))
+		return (-1);
+
+	strcpy(dir, path);
+	fd = open(dirname(dir), O_RDONLY | O_DIRECTORY);
+	if (fd == -1)
+		return (-1);
+
+	ret = fsync(fd);
+	close(fd);
+
+	return (ret == 0 ? 0 : -1);
+}
+
+
+
+/**
+ * hblk_journal_open - program that opens the journal of a blockchain
+ *
+ * the journal is created, with its header, if it doesn't exist yet;
+ * otherwise the tail torn by a crash, if any, is cut off, so records are
+ * always appended right after the last valid one
+ *
+ * @path: the path to the journal file
+ * @max_pending: the number of pending records triggering an fsync;
+ *               1 to sync every record, 0 to only sync on demand
+ * @max_delay_ms: the latency budget, in milliseconds: maximum time a
+ *                record may stay pending; 0 for no budget
+ *
+ * Return: a pointer to the opened journal, or NULL on failure
+ */
+
+hblk_journal_t *hblk_journal_open(char const *path, uint32_t max_pending,
+				  uint32_t max_delay_ms)
+{
+	hblk_journal_t *journal;
+	off_t size, end = 0;
+
+	journal = calloc(1, sizeof(*journal));
+	if (!path || !journal)
+	{
+		free(journal);
+		return (NULL);
+	}
+	journal->max_pending = max_pending;
+	journal->max_delay = (uint64_t)max_delay_ms * 1000000;
+
+	journal->fd = open(path, O_WRONLY | O_APPEND | O_CREAT, 0644);
+	if (journal->fd == -1)
+	{
+		free(journal);
+		return (NULL);
+	}
+
+	size = lseek(journal->fd, 0, SEEK_END);
+	if (size < 0 || (size && hblk_journal_replay(NULL, path, &end) < 0) ||
+	    (end == 0 &&
+	     (hblk_journal_reset(journal) != 0 || hblk_sync_dir(path) != 0)) ||
+	    (end && end < size &&
+	     (ftruncate(journal->fd, end) != 0 || fsync(journal->fd) != 0)))
+	{
+		close(journal->fd);
+		free(journal);
+		return (NULL);
+	}
+
+	return (journal);
+}
+
+
+
+/**
+ * hblk_journal_append - program that writes an appended block to
+ * the journal
+ *
+ * the record (the block as in a .hblk file, followed by its CRC32C) is
+ * written with a single write; it is then fsynced along with the other
+ * pending records once the count or latency budget of the journal is
+ * reached (group commit); the budget is checked on each append, so
+ * hblk_journal_sync() must be called once appends stop
+ *
+ * @journal: a pointer to the journal
+ * @block: a pointer to the appended block
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_journal_append(hblk_journal_t *journal, block_t const *block)
+{
+	uint8_t record[sizeof(block_info_t) + sizeof(uint32_t) +
+		       BLOCKCHAIN_DATA_MAX + SHA256_DIGEST_LENGTH +
+		       sizeof(uint32_t)];
+	size_t len = 0;
+	uint32_t crc;
+	struct timespec now;
+
+	if (!journal || !block || block->data.len > BLOCKCHAIN_DATA_MAX)
+		return (-1);
+
+	memcpy(record, &block->info, sizeof(block->info));
+	len += sizeof(block->info);
+	memcpy(record + len, &block->data.len, sizeof(block->data.len));
+	len += sizeof(block->data.len);
+	memcpy(record + len, block->data.buffer, block->data.len);
+	len += block->data.len;
+	memcpy(record + len, block->hash, SHA256_DIGEST_LENGTH);
+	len += SHA256_DIGEST_LENGTH;
+	crc = crc32c(0, record, len);
+	memcpy(record + len, &crc, sizeof(crc));
+	len += sizeof(crc);
+
+	if (write(journal->fd, record, len) != (ssize_t)len)
+		return (-1);
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	if (journal->pending++ == 0)
+		journal->oldest = now;
+
+	if ((journal->max_pending &&
+	     journal->pending >= journal->max_pending) ||
+	    (journal->max_delay &&
+	     (uint64_t)((now.tv_sec - journal->oldest.tv_sec) * 1000000000 +
+			(now.tv_nsec - journal->oldest.tv_nsec)) >=
+	     journal->max_delay))
+		return (hblk_journal_sync(journal));
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_journal_sync - program that makes every pending record of
+ * a journal durable
+ *
+ * @journal: a pointer to the journal
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_journal_sync(hblk_journal_t *journal)
+{
+	if (!journal)
+		return (-1);
+
+	if (journal->pending == 0)
+		return (0);
+
+	if (fdatasync(journal->fd) != 0)
+		return (-1);
+
+	journal->pending = 0;
+	journal->syncs++;
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_journal_close - program that syncs and closes a journal
+ *
+ * @journal: a pointer to the journal to close
+ *
+ * Return: 0 on success, -1 if the pending records could not be synced
+ */
+
+int hblk_journal_close(hblk_journal_t *journal)
+{
+	int ret;
+
+	if (!journal)
+		return (-1);
+
+	ret = hblk_journal_sync(journal);
+	if (close(journal->fd) != 0)
+		ret = -1;
+	free(journal);
+
+	return (ret);
+}
@@ -0,0 +1,114 @@
+#include "blockchain.h"
+
+/**
+ * replay_block - program that applies a single journal record to
+ * a blockchain
+ *
+ * blocks already in the blockchain (e.g. covered by the last snapshot)
+ * are skipped, the others must extend the tip of the active chain
+ *
+ * @blockchain: a pointer to the blockchain
+ * @block: a pointer to the block read from the journal
+ *
+ * Return: 1 if the block was appended, 0 if it was skipped, -1 if it
+ *         doesn't extend the chain (the block is then freed)
+ */
+
+static int replay_block(blockchain_t *blockchain, block_t *block)
+{
+	block_t *tip = llist_get_tail(blockchain->chain);
+
+	if (block_index_find(&blockchain->by_hash, block->hash))
+	{
+		free(block);
+		return (0);
+	}
+
+	if (!tip || block->info.index != tip->info.index + 1 ||
+	    memcmp(block->info.prev_hash, tip->hash, SHA256_DIGEST_LENGTH) ||
+	    blockchain_add_block(blockchain, block) != 0)
+	{
+		free(block);
+		return (-1);
+	}
+
+	return (1);
+}
+
+
+
+/**
+ * hblk_journal_replay - program that replays a journal onto a blockchain
+ *
+ * this is used after a crash, on the blockchain loaded from the last
+ * snapshot: the records of the journal are read in order, and the blocks
+ * the snapshot doesn't have are appended;
+ * the replay stops at the first truncated record, or record failing its
+ * CRC32C, which is the tail torn by the crash; hblk_journal_open() cuts
+ * that tail off at @end, so records appended afterwards can be replayed
+ *
+ * @blockchain: a pointer to the blockchain to replay the journal onto,
+ *              or NULL to only find the end of the valid records
+ * @path: the path to the journal file
+ * @end: if not NULL, set to the offset just past the last valid record
+ *       (0 if even the header of the journal is truncated)
+ *
+ * Return: the number of blocks appended (or valid records, without
+ *         @blockchain), or -1 if the journal cannot be opened, is invalid,
+ *         or doesn't extend the blockchain
+ */
+
+int hblk_journal_replay(blockchain_t *blockchain, char const *path,
+			off_t *end)
+{
+	hblk_reader_t reader;
+	uint8_t header[HBLJ_HEADER_SIZE];
+	block_info_t info;
+	block_t *block;
+	int suspect, ret, replayed = 0;
+	off_t valid = 0;
+
+	if (!path)
+		return (-1);
+
+	memset(&reader, 0, sizeof(reader));
+	reader.flags = HBLK_CRC32C;
+	reader.file = fopen(path, "rb");
+	if (!reader.file)
+		return (-1);
+	setvbuf(reader.file, NULL, _IOFBF, HBLK_IO_BUFSIZE);
+
+	/* a header torn when the journal was created leaves nothing to read */
+	if (fread(header, sizeof(header), 1, reader.file) == 1)
+	{
+		if (memcmp(header, HBLJ_MAG HBLJ_VER, sizeof(header) - 1) ||
+		    header[sizeof(header) - 1] != _get_endianness())
+			replayed = -1;
+		else
+			valid = sizeof(header);
+	}
+
+	while (replayed >= 0 &&
+	       (block = hblk_read_block(&reader, &info, &suspect)) != NULL)
+	{
+		block->info = info;
+		if (suspect)
+		{
+			free(block);
+			break;
+		}
+		ret = 1;
+		if (blockchain)
+			ret = replay_block(blockchain, block);
+		else
+			free(block);
+		replayed = ret < 0 ? -1 : replayed + ret;
+		if (ret >= 0)
+			valid = ftello(reader.file);
+	}
+
+	fclose(reader.file);
+	if (end)
+		*end = valid;
+	return (replayed);
+}
@@ -0,0 +1,34 @@
+#include "blockchain.h"
+
+/**
+ * hblk_journal_reset - program that empties a journal
+ *
+ * the journal only has to hold the blocks appended since the blockchain
+ * was last saved: once blockchain_serialize_flags() with HBLK_DURABLE, or
+ * a snapshot written with it, has succeeded, the records are dropped and
+ * only the header is left; a crash during the reset leaves at worst an
+ * empty journal, which hblk_journal_open() rewrites
+ *
+ * @journal: a pointer to the journal to reset
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_journal_reset(hblk_journal_t *journal)
+{
+	uint8_t header[HBLJ_HEADER_SIZE];
+
+	if (!journal)
+		return (-1);
+
+	memcpy(header, HBLJ_MAG HBLJ_VER, sizeof(header) - 1);
+	header[sizeof(header) - 1] = _get_endianness();
+	if (ftruncate(journal->fd, 0) != 0 ||
+	    write(journal->fd, header, sizeof(header)) != sizeof(header) ||
+	    fsync(journal->fd) != 0)
+		return (-1);
+
+	journal->pending = 0;
+
+	return (0);
+}
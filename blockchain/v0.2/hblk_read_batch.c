@@ -0,0 +1,231 @@
+#include "blockchain.h"
+
+/**
+ * record_check - program that checks a block record against its CRC32C
+ *
+ * the CRC32C is computed over the bytes of the record as they were read,
+ * so before byte-swapping and inflating
+ *
+ * @reader: the state of the file being loaded
+ * @info: a pointer to the block info, as read
+ * @len: the stored length of the payload, as read
+ * @data: a pointer to the payload, as read
+ * @block: a pointer to the block being read, with its hash, and the length
+ *         of its payload as stored
+ *
+ * Return: 0 if the record matches its CRC32C, 1 if it doesn't, -1 if the
+ *         CRC32C cannot be read
+ */
+
+static int record_check(hblk_reader_t *reader, block_info_t const *info,
+			uint32_t len, void const *data, block_t const *block)
+{
+	uint32_t crc;
+
+	if (fread(&crc, sizeof(crc), 1, reader->file) != 1)
+		return (-1);
+	crc = reader->swap ? __builtin_bswap32(crc) : crc;
+
+	return (crc32c(crc32c(crc32c(crc32c(0, info, sizeof(*info)),
+		&len, sizeof(len)), data, block->data.len),
+		block->hash, SHA256_DIGEST_LENGTH) != crc);
+}
+
+
+
+/**
+ * record_decode - program that decodes the compressed or deduplicated
+ * payload of a block record
+ *
+ * @reader: the state of the file being loaded
+ * @size: the stored length of the payload, byte-swapped if needed
+ * @payload: a pointer to the payload, as read
+ * @block: a pointer to the block being read, with the length of its
+ *         payload as stored
+ *
+ * Return: 0 on success, -1 if the payload is invalid
+ */
+
+static int record_decode(hblk_reader_t *reader, uint32_t size,
+			 uint8_t const *payload, block_t *block)
+{
+	uint32_t ref;
+
+	if (!(size & HBLK_REF_BIT))
+		return (hblk_inflate(reader->zstream, payload, block->data.len,
+				     &block->data));
+
+	memcpy(&ref, payload, sizeof(ref));
+	ref = reader->swap ? __builtin_bswap32(ref) : ref;
+	if ((size & HBLK_Z_BIT) || block->data.len != sizeof(ref) ||
+	    !(reader->flags & HBLK_DEDUP) || ref >= reader->pos)
+		return (-1);
+
+	memcpy(&block->data, &reader->loaded[ref]->data, sizeof(block->data));
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_read_block - program that reads a single block record from a .hblk
+ * file (or a journal)
+ *
+ * the block info is read into a separate array, so the infos of a whole
+ * batch of blocks can be byte-swapped at once;
+ * when the file carries CRCs, the record is checked against its CRC32C;
+ * a raw payload is read in place, while a compressed (HBLK_Z_BIT set in
+ * its stored length) or deduplicated (HBLK_REF_BIT) one is decoded into
+ * the block; a header-only record (HBLK_PRUNED_BIT) yields a block without
+ * payload, and is only accepted in a file with HBLK_PRUNED, right after
+ * the Genesis Block or another header-only record; with HBLK_DEDUP, the
+ * block is kept in the loaded array of @reader, grown as blocks are read
+ * rather than sized from the (untrusted) header
+ *
+ * @reader: the state of the file being loaded
+ * @info: the address at which to store the block info, as read
+ * @suspect: set to 1 if the record doesn't match its CRC32C
+ *
+ * Return: a pointer to the newly allocated block, without its info, or NULL
+ *         if the record is truncated or invalid
+ */
+
+block_t *hblk_read_block(hblk_reader_t *reader, block_info_t *info,
+			 int *suspect)
+{
+	uint8_t payload[BLOCKCHAIN_DATA_MAX], *data;
+	block_t *block = calloc(1, sizeof(*block)), **loaded;
+	uint32_t len, size, capacity;
+
+	if (!block || fread(info, sizeof(*info), 1, reader->file) != 1 ||
+	    fread(&len, sizeof(len), 1, reader->file) != 1)
+	{
+		free(block);
+		return (NULL);
+	}
+
+	size = reader->swap ? __builtin_bswap32(len) : len;
+	data = size & (HBLK_Z_BIT | HBLK_REF_BIT) ?
+		payload : (uint8_t *)block->data.buffer;
+	block->data.len = size & ~HBLK_LEN_FLAGS;
+	*suspect = 0;
+	if (block->data.len > BLOCKCHAIN_DATA_MAX ||
+	    ((size & HBLK_PRUNED_BIT) &&
+	     (!(reader->flags & HBLK_PRUNED) || block->data.len ||
+	      reader->pos != reader->pruned + 1)) ||
+	    fread(data, 1, block->data.len, reader->file) != block->data.len ||
+	    fread(block->hash, SHA256_DIGEST_LENGTH, 1, reader->file) != 1 ||
+	    ((reader->flags & HBLK_CRC32C) &&
+	     (*suspect = record_check(reader, info, len, data, block)) < 0) ||
+	    (data == payload && record_decode(reader, size, payload, block)))
+	{
+		free(block);
+		return (NULL);
+	}
+
+	if ((reader->flags & HBLK_DEDUP) && reader->pos == reader->capacity)
+	{
+		capacity = reader->capacity ? reader->capacity * 2 :
+			HBLK_LOAD_BATCH;
+		loaded = realloc(reader->loaded, capacity * sizeof(*loaded));
+		if (!loaded)
+		{
+			free(block);
+			return (NULL);
+		}
+		reader->loaded = loaded;
+		reader->capacity = capacity;
+	}
+	if (reader->flags & HBLK_DEDUP)
+		reader->loaded[reader->pos] = block;
+	if (size & HBLK_PRUNED_BIT)
+		reader->pruned = reader->pos;
+	reader->pos++;
+
+	return (block);
+}
+
+
+
+/**
+ * block_is_sound - program that checks a loaded block
+ *
+ * a block whose record failed its CRC32C, or every block with HBLK_VERIFY,
+ * has its hash recomputed; a header-only block can't be hashed, so it is
+ * only checked against its CRC32C
+ *
+ * @reader: the state of the file being loaded
+ * @block: a pointer to the block to check
+ * @suspect: 1 if the record of the block doesn't match its CRC32C
+ * @pos: the position of the block in the file
+ *
+ * Return: 1 if the block is sound, 0 otherwise
+ */
+
+static int block_is_sound(hblk_reader_t const *reader, block_t const *block,
+			  int suspect, uint32_t pos)
+{
+	uint8_t hash[SHA256_DIGEST_LENGTH];
+
+	if (pos && pos <= reader->pruned)
+		return (!suspect);
+	if (!suspect && !(reader->flags & HBLK_VERIFY))
+		return (1);
+
+	return (block_hash(block, hash) &&
+		!memcmp(hash, block->hash, SHA256_DIGEST_LENGTH));
+}
+
+
+
+/**
+ * hblk_read_batch - program that reads a batch of blocks from a .hblk file
+ * and appends them to a blockchain
+ *
+ * every block is checked with block_is_sound(), and the batch is rejected
+ * if one of them isn't
+ *
+ * @reader: the state of the file being loaded
+ * @blockchain: a pointer to the blockchain to append the blocks to
+ * @n: the number of blocks to read, at most HBLK_LOAD_BATCH
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_read_batch(hblk_reader_t *reader, blockchain_t *blockchain,
+		    uint32_t n)
+{
+	block_info_t infos[HBLK_LOAD_BATCH];
+	block_t *blocks[HBLK_LOAD_BATCH];
+	int suspect[HBLK_LOAD_BATCH];
+	uint32_t i, pos = reader->pos;
+
+	for (i = 0; i < n; i++)
+	{
+		blocks[i] = hblk_read_block(reader, &infos[i], &suspect[i]);
+		if (!blocks[i])
+		{
+			while (i--)
+				free(blocks[i]);
+			return (-1);
+		}
+	}
+
+	if (reader->swap)
+		block_info_swap(infos, n);
+
+	for (i = 0; i < n; i++)
+	{
+		blocks[i]->info = infos[i];
+		if (!block_is_sound(reader, blocks[i], suspect[i], pos + i) ||
+		    blockchain_add_block(blockchain, blocks[i]) != 0)
+			break;
+	}
+	if (i == n)
+		return (0);
+
+	while (i < n)
+		free(blocks[i++]);
+	return (-1);
+}
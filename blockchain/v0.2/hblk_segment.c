@@ -0,0 +1,160 @@
+#include "blockchain.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * segment_scan - program that locates and checks the records of a mapped
+ * segment
+ *
+ * the header and every record are checked against their CRC32C, which
+ * runs at memory bandwidth, and the offset of each record is stored;
+ * the number of records is first checked against the size of the
+ * segment, so a forged one can't overflow the offsets array;
+ * records are raw, or header-only once pruned (see hblk_store_prune()),
+ * in which case the revision of the segment has HBLK_REV_PRUNED
+ *
+ * @segment: a pointer to the segment, with its mapping set
+ *
+ * Return: 0 on success, -1 if the segment is truncated or corrupted
+ */
+
+static int segment_scan(hblk_segment_t *segment)
+{
+	uint8_t const *map = segment->map;
+	size_t off = 16, len;
+	uint32_t i, crc, data_len, pruned;
+
+	if (segment->size < off || memcmp(map, HBLK_MAG HBLK_VER, 6) ||
+	    ((map[6] - HBLK_VER[2]) & ~HBLK_REV_PRUNED) != HBLK_REV_CRC32C ||
+	    map[7] != _get_endianness())
+		return (-1);
+	pruned = (map[6] - HBLK_VER[2]) & HBLK_REV_PRUNED ? HBLK_PRUNED_BIT : 0;
+	memcpy(&segment->count, map + 8, sizeof(segment->count));
+	memcpy(&crc, map + 12, sizeof(crc));
+	if (crc != crc32c(0, map, 12) || segment->count >
+	    (segment->size - off) / (HBLK_RECORD_SIZE + sizeof(crc)))
+		return (-1);
+
+	segment->offsets = malloc((segment->count + 1) * sizeof(uint32_t));
+	if (!segment->offsets)
+		return (-1);
+
+	for (i = 0; i < segment->count; i++, off += len + sizeof(crc))
+	{
+		if (segment->size < off + HBLK_RECORD_SIZE + sizeof(crc))
+			return (-1);
+		memcpy(&data_len, map + off + sizeof(block_info_t),
+		       sizeof(data_len));
+		data_len &= ~pruned;
+		len = HBLK_RECORD_SIZE + data_len;
+		if (data_len > BLOCKCHAIN_DATA_MAX ||
+		    segment->size < off + len + sizeof(crc))
+			return (-1);
+		memcpy(&crc, map + off + len, sizeof(crc));
+		if (crc != crc32c(0, map + off, len))
+			return (-1);
+		segment->offsets[i] = (uint32_t)off;
+	}
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_segment_map - program that maps a segment file in memory
+ *
+ * @segment: a pointer to the segment to map
+ * @path: the path to the segment file
+ *
+ * Return: 0 on success, -1 if the file cannot be mapped, or is truncated
+ *         or corrupted
+ */
+
+int hblk_segment_map(hblk_segment_t *segment, char const *path)
+{
+	struct stat st;
+	void *map;
+	int fd;
+
+	if (!segment || !path)
+		return (-1);
+
+	fd = open(path, O_RDONLY);
+	if (fd == -1)
+		return (-1);
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		close(fd);
+		return (-1);
+	}
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return (-1);
+
+	memset(segment, 0, sizeof(*segment));
+	segment->map = map;
+	segment->size = st.st_size;
+	if (segment_scan(segment) != 0)
+	{
+		hblk_segment_unmap(segment);
+		return (-1);
+	}
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_segment_unmap - program that unmaps a segment
+ *
+ * @segment: a pointer to the segment to unmap
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_segment_unmap(hblk_segment_t *segment)
+{
+	if (!segment)
+		return;
+
+	if (segment->map)
+		munmap(segment->map, segment->size);
+	free(segment->offsets);
+	memset(segment, 0, sizeof(*segment));
+}
+
+
+
+/**
+ * hblk_segment_get - program that copies a block out of a mapped segment
+ *
+ * @segment: a pointer to the mapped segment
+ * @pos: the position of the block in the segment
+ * @block: the address at which to store the block
+ *
+ * Return: 0 on success, -1 if @pos is out of range
+ */
+
+int hblk_segment_get(hblk_segment_t const *segment, uint32_t pos,
+		     block_t *block)
+{
+	uint8_t const *record;
+
+	if (!segment || !segment->map || !block || pos >= segment->count)
+		return (-1);
+
+	record = segment->map + segment->offsets[pos];
+	memset(block, 0, sizeof(*block));
+	memcpy(&block->info, record, sizeof(block->info));
+	record += sizeof(block->info);
+	memcpy(&block->data.len, record, sizeof(block->data.len));
+	block->data.len &= ~HBLK_PRUNED_BIT;
+	record += sizeof(block->data.len);
+	memcpy(block->data.buffer, record, block->data.len);
+	memcpy(block->hash, record + block->data.len, SHA256_DIGEST_LENGTH);
+
+	return (0);
+}
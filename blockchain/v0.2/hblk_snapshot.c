@@ -0,0 +1,169 @@
+#include "blockchain.h"
+
+/**
+ * snapshot_capture - program that copies the block pointers of the active
+ * chain into a cursor
+ *
+ * with a chain view, its array is copied at once; otherwise the pointers
+ * are gathered in a single pass over the list
+ *
+ * @cursor: the address of the cursor to fill in; it owns the copy
+ * @blockchain: a pointer to the blockchain
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+static int snapshot_capture(chain_cursor_t *cursor,
+			    blockchain_t const *blockchain)
+{
+	chain_view_t *view = blockchain->view;
+	chain_array_t *array, *src;
+	uint32_t size;
+
+	memset(cursor, 0, sizeof(*cursor));
+	if (!view || view->stale)
+	{
+		array = chain_array_build(blockchain->chain, 0);
+	}
+	else
+	{
+		src = atomic_load(&view->array);
+		size = atomic_load(&src->size);
+		array = calloc(1, sizeof(*array) + size * sizeof(src->blocks[0]));
+		if (array)
+		{
+			memcpy(array->blocks, src->blocks,
+			       size * sizeof(src->blocks[0]));
+			array->capacity = size;
+			atomic_init(&array->size, size);
+		}
+	}
+	if (!array)
+		return (-1);
+
+	cursor->array = array;
+	cursor->blocks = (block_t * const *)array->blocks;
+	cursor->size = atomic_load(&array->size);
+	cursor->pruned = blockchain->pruned;
+
+	return (0);
+}
+
+
+
+/**
+ * snapshot_run - program that writes a snapshot, on its own thread
+ *
+ * @arg: a pointer to the snapshot
+ *
+ * Return: NULL
+ */
+
+static void *snapshot_run(void *arg)
+{
+	hblk_snapshot_t *snapshot = (hblk_snapshot_t *)arg;
+
+	snapshot->status = hblk_write_progress(snapshot->path,
+					       &snapshot->cursor,
+					       snapshot->flags,
+					       snapshot->progress,
+					       snapshot->arg);
+	chain_cursor_close(&snapshot->cursor);
+	atomic_fetch_sub_explicit(&snapshot->blockchain->snapshots, 1,
+				  memory_order_release);
+
+	if (snapshot->done)
+		snapshot->done(snapshot->status, snapshot->arg);
+
+	return (NULL);
+}
+
+
+
+/**
+ * blockchain_snapshot_async - program that serializes a blockchain to
+ * a file in the background
+ *
+ * the chain is captured as it is when this function is called, by copying
+ * the pointers to its blocks, which costs a small fraction of writing
+ * them; blocks can then keep being appended (or the chain reorganized)
+ * while the snapshot is written;
+ * the blockchain must not be destroyed before hblk_snapshot_wait()
+ * returns, and it can't be pruned before the snapshot is written
+ *
+ * @blockchain: a pointer to the blockchain to serialize
+ * @path: the file path where the blockchain should be saved
+ * @flags: the serialization flags (see blockchain_serialize_flags())
+ * @progress: called on the snapshot thread every HBLK_PROGRESS_STEP blocks
+ *            and once all of them are written, may be NULL
+ * @done: called on the snapshot thread once it is over, may be NULL
+ * @arg: the argument passed to @progress and @done
+ *
+ * Return: a pointer to the snapshot in progress, to pass to
+ *         hblk_snapshot_wait(), or NULL on failure
+ */
+
+hblk_snapshot_t *blockchain_snapshot_async(blockchain_t *blockchain,
+					   char const *path,
+					   unsigned int flags,
+					   hblk_progress_t progress,
+					   hblk_done_t done, void *arg)
+{
+	hblk_snapshot_t *snapshot;
+
+	if (!blockchain || !path)
+		return (NULL);
+
+	snapshot = calloc(1, sizeof(*snapshot));
+	if (!snapshot)
+		return (NULL);
+	snapshot->path = strdup(path);
+	snapshot->flags = flags;
+	snapshot->progress = progress;
+	snapshot->done = done;
+	snapshot->arg = arg;
+	snapshot->blockchain = blockchain;
+
+	atomic_fetch_add_explicit(&blockchain->snapshots, 1,
+				  memory_order_relaxed);
+	if (!snapshot->path ||
+	    snapshot_capture(&snapshot->cursor, blockchain) != 0 ||
+	    pthread_create(&snapshot->thread, NULL, snapshot_run, snapshot))
+	{
+		atomic_fetch_sub_explicit(&blockchain->snapshots, 1,
+					  memory_order_relaxed);
+		chain_cursor_close(&snapshot->cursor);
+		free(snapshot->path);
+		free(snapshot);
+		return (NULL);
+	}
+
+	return (snapshot);
+}
+
+
+
+/**
+ * hblk_snapshot_wait - program that waits for a background snapshot to be
+ * written, and frees it
+ *
+ * @snapshot: a pointer to the snapshot returned by
+ *            blockchain_snapshot_async()
+ *
+ * Return: 0 if the snapshot was written, -1 on failure
+ */
+
+int hblk_snapshot_wait(hblk_snapshot_t *snapshot)
+{
+	int status;
+
+	if (!snapshot)
+		return (-1);
+
+	pthread_join(snapshot->thread, NULL);
+	status = snapshot->status;
+	free(snapshot->path);
+	free(snapshot);
+
+	return (status);
+}
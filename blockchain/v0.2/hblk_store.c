@@ -0,0 +1,206 @@
+#include "blockchain.h"
+#include <sys/stat.h>
+
+/**
+ * manifest_read - program that reads the manifest of a store
+ *
+ * @store: a pointer to the store; its seg_height and nsealed members are
+ *         set from the manifest
+ * @path: the path to the manifest
+ *
+ * Return: 0 on success, 1 if there is no manifest yet, -1 if it is invalid
+ */
+
+static int manifest_read(hblk_store_t *store, char const *path)
+{
+	uint8_t manifest[sizeof(HBLM_MAG) - 1 + sizeof(HBLM_VER) - 1 + 1 + 12];
+	FILE *file = fopen(path, "rb");
+	uint32_t crc;
+	size_t len;
+
+	if (!file)
+		return (1);
+	len = fread(manifest, 1, sizeof(manifest), file);
+	fclose(file);
+
+	if (len != sizeof(manifest) ||
+	    memcmp(manifest, HBLM_MAG HBLM_VER, sizeof(manifest) - 13) ||
+	    manifest[7] != _get_endianness())
+		return (-1);
+
+	memcpy(&store->seg_height, manifest + 8, sizeof(uint32_t));
+	memcpy(&store->nsealed, manifest + 12, sizeof(uint32_t));
+	memcpy(&crc, manifest + 16, sizeof(uint32_t));
+
+	return (crc == crc32c(0, manifest, 16) && store->seg_height ? 0 : -1);
+}
+
+
+
+/**
+ * hblk_store_manifest_write - program that durably writes the manifest of
+ * a store
+ *
+ * the manifest holds the segment height and the number of sealed segments;
+ * it is written to a temporary file, fsynced, then renamed
+ *
+ * @store: a pointer to the store
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_store_manifest_write(hblk_store_t const *store)
+{
+	uint8_t manifest[sizeof(HBLM_MAG) - 1 + sizeof(HBLM_VER) - 1 + 1 + 12];
+	char path[PATH_MAX], tmp[PATH_MAX + 4];
+	uint32_t crc;
+	int fd, err;
+
+	memcpy(manifest, HBLM_MAG HBLM_VER, sizeof(manifest) - 13);
+	manifest[7] = _get_endianness();
+	memcpy(manifest + 8, &store->seg_height, sizeof(uint32_t));
+	memcpy(manifest + 12, &store->nsealed, sizeof(uint32_t));
+	crc = crc32c(0, manifest, 16);
+	memcpy(manifest + 16, &crc, sizeof(uint32_t));
+
+	snprintf(path, sizeof(path), HBLK_MANIFEST, store->dir);
+	snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+	fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd == -1)
+		return (-1);
+	err = write(fd, manifest, sizeof(manifest)) != sizeof(manifest) ||
+		fsync(fd) != 0;
+	if (close(fd) != 0 || err || rename(tmp, path) != 0)
+		return (-1);
+
+	return (hblk_sync_dir(path));
+}
+
+
+
+/**
+ * active_load - program that loads the active segment of a store
+ *
+ * if the active segment turns out to be full (a crash happened while it
+ * was being sealed), it is sealed right away
+ *
+ * @store: a pointer to the store
+ *
+ * Return: 0 on success, -1 if the active segment is corrupted
+ */
+
+static int active_load(hblk_store_t *store)
+{
+	hblk_segment_t segment;
+	char path[PATH_MAX];
+	uint32_t i, count;
+
+	snprintf(path, sizeof(path), HBLK_SEGMENT, store->dir, store->nsealed);
+	if (access(path, F_OK) != 0)
+		return (0);
+	if (hblk_segment_map(&segment, path) != 0 ||
+	    segment.count > store->seg_height)
+		return (-1);
+
+	count = segment.count;
+	for (i = 0; i < count; i++)
+	{
+		store->active[i] = malloc(sizeof(block_t));
+		if (!store->active[i] ||
+		    hblk_segment_get(&segment, i, store->active[i]) != 0)
+			break;
+		store->nactive++;
+	}
+	hblk_segment_unmap(&segment);
+	if (store->nactive != count)
+		return (-1);
+
+	if (store->nactive == store->seg_height)
+		return (hblk_store_flush(store));
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_store_open - program that opens (or creates) a segmented store
+ *
+ * only the manifest and the active segment are read; sealed segments are
+ * mapped on first access
+ *
+ * @dir: the path to the directory of the store, created if needed
+ * @seg_height: the number of blocks per segment of a new store; an
+ *              existing store keeps the height recorded in its manifest
+ *
+ * Return: a pointer to the opened store, or NULL on failure
+ */
+
+hblk_store_t *hblk_store_open(char const *dir, uint32_t seg_height)
+{
+	hblk_store_t *store = calloc(1, sizeof(*store));
+	char path[PATH_MAX];
+	int ret;
+
+	if (!store || !dir || !seg_height ||
+	    (mkdir(dir, 0755) != 0 && access(dir, W_OK) != 0))
+	{
+		free(store);
+		return (NULL);
+	}
+	store->dir = strdup(dir);
+	store->seg_height = seg_height;
+	snprintf(path, sizeof(path), HBLK_MANIFEST, dir);
+
+	ret = store->dir ? manifest_read(store, path) : -1;
+	if (ret == 1)
+		ret = hblk_store_manifest_write(store);
+	if (ret == 0)
+	{
+		store->sealed = calloc(store->nsealed + 1, sizeof(*store->sealed));
+		store->active = calloc(store->seg_height, sizeof(block_t *));
+		ret = store->sealed && store->active ? active_load(store) : -1;
+	}
+	if (ret != 0)
+	{
+		while (store->active && store->nactive)
+			free(store->active[--store->nactive]);
+		hblk_store_close(store);
+		return (NULL);
+	}
+
+	return (store);
+}
+
+
+
+/**
+ * hblk_store_close - program that flushes and closes a store
+ *
+ * @store: a pointer to the store to close
+ *
+ * Return: 0 on success, -1 if the active segment could not be flushed
+ */
+
+int hblk_store_close(hblk_store_t *store)
+{
+	uint32_t i;
+	int ret = 0;
+
+	if (!store)
+		return (-1);
+
+	if (store->active && store->sealed && store->nactive)
+		ret = hblk_store_flush(store);
+
+	for (i = 0; store->sealed && i < store->nsealed; i++)
+		hblk_segment_unmap(&store->sealed[i]);
+	for (i = 0; store->active && i < store->nactive; i++)
+		free(store->active[i]);
+	free(store->sealed);
+	free(store->active);
+	free(store->dir);
+	free(store);
+
+	return (ret);
+}
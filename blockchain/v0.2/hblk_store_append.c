@@ -0,0 +1,172 @@
+#include "blockchain.h"
+
+/**
+ * hblk_store_size - program that computes the number of blocks of a store
+ *
+ * @store: a pointer to the store
+ *
+ * Return: the number of blocks in the store
+ */
+
+uint32_t hblk_store_size(hblk_store_t const *store)
+{
+	if (!store)
+		return (0);
+
+	return (store->nsealed * store->seg_height + store->nactive);
+}
+
+
+
+/**
+ * hblk_store_get - program that retrieves a block of a store given its
+ * index
+ *
+ * blocks of a sealed segment are read from its mapping, the segment being
+ * mapped on first access
+ *
+ * @store: a pointer to the store
+ * @index: the index of the block in the chain
+ * @block: the address at which to store a copy of the block
+ *
+ * Return: 0 on success, -1 if there is no such block, or its segment can't
+ *         be mapped
+ */
+
+int hblk_store_get(hblk_store_t *store, uint32_t index, block_t *block)
+{
+	hblk_segment_t *segment;
+	char path[PATH_MAX];
+	uint32_t seg, pos;
+
+	if (!store || !block)
+		return (-1);
+
+	seg = index / store->seg_height;
+	pos = index % store->seg_height;
+	if (seg == store->nsealed && pos < store->nactive)
+	{
+		memcpy(block, store->active[pos], sizeof(*block));
+		return (0);
+	}
+	if (seg >= store->nsealed)
+		return (-1);
+
+	segment = &store->sealed[seg];
+	snprintf(path, sizeof(path), HBLK_SEGMENT, store->dir, seg);
+	if (!segment->map && hblk_segment_map(segment, path) != 0)
+		return (-1);
+
+	return (hblk_segment_get(segment, pos, block));
+}
+
+
+
+/**
+ * store_seal - program that seals the full active segment of a store
+ *
+ * the segment file was durably written; it becomes immutable once the
+ * manifest counts it as sealed, and a new empty active segment starts
+ *
+ * @store: a pointer to the store
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+static int store_seal(hblk_store_t *store)
+{
+	hblk_segment_t *sealed;
+	uint32_t i;
+
+	sealed = realloc(store->sealed, (store->nsealed + 2) * sizeof(*sealed));
+	if (!sealed)
+		return (-1);
+	store->sealed = sealed;
+	memset(&sealed[store->nsealed + 1], 0, sizeof(*sealed));
+
+	store->nsealed++;
+	if (hblk_store_manifest_write(store) != 0)
+	{
+		store->nsealed--;
+		return (-1);
+	}
+
+	for (i = 0; i < store->nactive; i++)
+		free(store->active[i]);
+	store->nactive = 0;
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_store_flush - program that durably writes the active segment of
+ * a store
+ *
+ * only the active segment is rewritten, so this costs at most one segment
+ * worth of I/O; a full active segment is then sealed
+ *
+ * @store: a pointer to the store
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_store_flush(hblk_store_t *store)
+{
+	chain_cursor_t cursor;
+	char path[PATH_MAX];
+
+	if (!store)
+		return (-1);
+
+	memset(&cursor, 0, sizeof(cursor));
+	cursor.blocks = (block_t * const *)store->active;
+	cursor.size = store->nactive;
+
+	snprintf(path, sizeof(path), HBLK_SEGMENT, store->dir, store->nsealed);
+	if (hblk_write(path, &cursor, HBLK_CRC32C | HBLK_DURABLE) != 0)
+		return (-1);
+
+	if (store->nactive == store->seg_height)
+		return (store_seal(store));
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_store_append - program that appends a block to a store
+ *
+ * the block is copied in the active segment, which is flushed and sealed
+ * once full; in between, appended blocks are only durable after
+ * hblk_store_flush() (or when journaled, see hblk_journal_append())
+ *
+ * @store: a pointer to the store
+ * @block: a pointer to the block to append
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_store_append(hblk_store_t *store, block_t const *block)
+{
+	block_t *copy;
+
+	if (!store || !block || store->nactive >= store->seg_height)
+		return (-1);
+
+	copy = malloc(sizeof(*copy));
+	if (!copy)
+		return (-1);
+	memcpy(copy, block, sizeof(*copy));
+	store->active[store->nactive++] = copy;
+
+	if (store->nactive == store->seg_height && hblk_store_flush(store) != 0)
+	{
+		free(store->active[--store->nactive]);
+		return (-1);
+	}
+
+	return (0);
+}
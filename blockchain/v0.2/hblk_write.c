@@ -0,0 +1,237 @@
+#include "blockchain.h"
+
+/**
+ * write_encoded - program that writes a block record with an encoded
+ * payload
+ *
+ * a pruned block is written without payload, with HBLK_PRUNED_BIT set in
+ * its stored length;
+ * with HBLK_DEDUP, a payload already written is replaced by the position
+ * of the first block carrying it, with HBLK_REF_BIT set in its stored
+ * length; otherwise, with HBLK_ZLIB, the stored length is the one returned
+ * by hblk_deflate(); the CRC32C covers the bytes as written
+ *
+ * @writer: the state of the file being written
+ * @block: a pointer to the block to write
+ * @pos: the position of the block in the file
+ * @pruned: the index of the last pruned block, 0 if none
+ *
+ * Return: the size of the record, in bytes
+ */
+
+static uint32_t write_encoded(hblk_writer_t *writer, block_t const *block,
+			  uint32_t pos, uint32_t pruned)
+{
+	uint8_t payload[BLOCKCHAIN_DATA_MAX];
+	void const *data = block->data.buffer;
+	uint32_t len = block->data.len, size, crc;
+	payload_t *dup = NULL;
+
+	if (block->info.index && block->info.index <= pruned)
+		len = HBLK_PRUNED_BIT;
+	else if (writer->payloads && len >= HBLK_DEDUP_MIN)
+		dup = payload_store_put(writer->payloads, block->data.buffer,
+					len, pos);
+	if (dup && dup->refs > 1)
+	{
+		len = HBLK_REF_BIT | sizeof(dup->first);
+		data = &dup->first;
+	}
+	else if (writer->zstream && !(len & HBLK_PRUNED_BIT))
+	{
+		len = hblk_deflate(writer->zstream, &block->data, payload);
+		data = len & HBLK_Z_BIT ? payload : data;
+	}
+	size = len & ~HBLK_LEN_FLAGS;
+
+	fwrite(&block->info, sizeof(block->info), 1, writer->file);
+	fwrite(&len, sizeof(len), 1, writer->file);
+	fwrite(data, 1, size, writer->file);
+	fwrite(block->hash, SHA256_DIGEST_LENGTH, 1, writer->file);
+
+	if (writer->flags & HBLK_CRC32C)
+	{
+		crc = crc32c(crc32c(crc32c(crc32c(0, &block->info,
+			sizeof(block->info)), &len, sizeof(len)), data, size),
+			block->hash, SHA256_DIGEST_LENGTH);
+		fwrite(&crc, sizeof(crc), 1, writer->file);
+		size += sizeof(crc);
+	}
+
+	return (HBLK_RECORD_SIZE + size);
+}
+
+
+
+/**
+ * hblk_write_block - program that writes a block record to a .hblk stream
+ *
+ * the block is serialized with write_block_to_file(), followed by its
+ * CRC32C with HBLK_CRC32C, or with write_encoded() with HBLK_ZLIB or
+ * HBLK_DEDUP, or if the block was pruned
+ *
+ * @writer: the state of the stream being written (see hblk_writer_init())
+ * @block: a pointer to the block to write
+ * @pos: the position of the block in the stream
+ * @pruned: the index of the last pruned block, 0 if none; ignored unless
+ *          the header was written with HBLK_PRUNED, so header-only records
+ *          never end up in a file older readers would misread
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_write_block(hblk_writer_t *writer, block_t const *block,
+		      uint32_t pos, uint32_t pruned)
+{
+	uint32_t crc, size;
+
+	if (!(writer->flags & HBLK_PRUNED))
+		pruned = 0;
+	if (writer->zstream || writer->payloads ||
+	    (block->info.index && block->info.index <= pruned))
+	{
+		size = write_encoded(writer, block, pos, pruned);
+	}
+	else
+	{
+		write_block_to_file((llist_node_t)block, pos, writer->file);
+		size = HBLK_RECORD_SIZE + block->data.len;
+		if (writer->flags & HBLK_CRC32C)
+		{
+			crc = block_crc32c(block);
+			fwrite(&crc, sizeof(crc), 1, writer->file);
+			size += sizeof(crc);
+		}
+	}
+
+	HBLK_STAT_ADD(HBLK_STAT_WRITE_BLOCKS, 1);
+	HBLK_STAT_ADD(HBLK_STAT_WRITE_BYTES, size);
+}
+
+
+
+/**
+ * write_blocks - program that writes the block records of a blockchain
+ *
+ * the blocks are iterated by batches with a chain cursor, and each one is
+ * written with hblk_write_block();
+ * progress is reported every HBLK_PROGRESS_STEP blocks, and at the end
+ *
+ * @writer: the state of the file being written
+ * @cursor: a cursor opened over the blockchain
+ *
+ * Return: nothing (void)
+ */
+
+static void write_blocks(hblk_writer_t *writer, chain_cursor_t *cursor)
+{
+	block_t const *batch[CHAIN_CURSOR_BATCH];
+	uint32_t count, i, idx = 0, total = cursor->size - cursor->pos;
+
+	while ((count = chain_cursor_batch(cursor, batch,
+					   CHAIN_CURSOR_BATCH)) != 0)
+	{
+		for (i = 0; i < count; i++, idx++)
+			hblk_write_block(writer, batch[i], idx, cursor->pruned);
+		if (writer->progress && (idx % HBLK_PROGRESS_STEP < count ||
+					 idx == total))
+			writer->progress(idx, total, writer->arg);
+	}
+}
+
+
+
+/**
+ * hblk_write_stream - program that writes the blocks yielded by a cursor to
+ * an opened stream, in the .hblk format
+ *
+ * nothing is ever sought, so the stream can be a pipe or a socket: the
+ * number of blocks, in the header, is known from the cursor up front, and
+ * so is whether pruned blocks are written (HBLK_PRUNED)
+ *
+ * @writer: the state of the stream being written; its file, flags,
+ *          progress and arg members must be set
+ * @cursor: a cursor yielding the blocks to write
+ *
+ * Return: 0 on success, -1 if the stream cannot be written
+ */
+
+int hblk_write_stream(hblk_writer_t *writer, chain_cursor_t *cursor)
+{
+	uint64_t start = HBLK_STAT_NOW(), span = HBLK_TRACE_BEGIN();
+	int ret = -1;
+
+	if (hblk_writer_init(writer) == 0)
+	{
+		if (cursor->pruned)
+			writer->flags |= HBLK_PRUNED;
+		hblk_write_header(writer, cursor->size - cursor->pos);
+		write_blocks(writer, cursor);
+		ret = ferror(writer->file) || fflush(writer->file) ? -1 : 0;
+	}
+	hblk_writer_clear(writer);
+	HBLK_STAT_ELAPSED(HBLK_STAT_WRITE_NS, start);
+	HBLK_TRACE_END("hblk_write", span);
+
+	return (ret);
+}
+
+
+
+/**
+ * hblk_write_progress - program that writes the blocks yielded by a cursor
+ * to a .hblk file, reporting its progress
+ *
+ * with HBLK_CRC32C, every record is followed by its CRC32C;
+ * with HBLK_ZLIB, payloads are deflated (see hblk_deflate());
+ * with HBLK_DEDUP, duplicate payloads are written once;
+ * with HBLK_DURABLE, the file is written to "<path>.tmp", which is
+ * fsynced then renamed over @path, so a crash leaves either the former or
+ * the new file, never a torn one
+ *
+ * @path: the file path where the blocks should be saved
+ * @cursor: a cursor yielding the blocks to write
+ * @flags: 0 for the original format, or any of HBLK_CRC32C, HBLK_ZLIB,
+ *         HBLK_DEDUP, HBLK_DURABLE
+ * @progress: called every HBLK_PROGRESS_STEP blocks, and once all of them
+ *            are written, may be NULL
+ * @arg: the argument passed to @progress
+ *
+ * Return: 0 on success, -1 if the file cannot be opened or written
+ */
+
+int hblk_write_progress(char const *path, chain_cursor_t *cursor,
+			unsigned int flags, hblk_progress_t progress,
+			void *arg)
+{
+	hblk_writer_t writer = {NULL, 0, NULL, NULL, NULL, NULL};
+	char tmp[PATH_MAX];
+	int err;
+
+	if (!path || !cursor || (size_t)snprintf(tmp, sizeof(tmp),
+	    "%s.tmp", path) >= sizeof(tmp))
+		return (-1);
+
+	writer.file = fopen(flags & HBLK_DURABLE ? tmp : path, "wb");
+	if (!writer.file)
+		return (-1);
+	setvbuf(writer.file, NULL, _IOFBF, HBLK_IO_BUFSIZE);
+	writer.flags = flags;
+	writer.progress = progress;
+	writer.arg = arg;
+
+	err = hblk_write_stream(&writer, cursor) ||
+		((flags & HBLK_DURABLE) && fsync(fileno(writer.file)));
+	if (fclose(writer.file) != 0 || err)
+	{
+		if (flags & HBLK_DURABLE)
+			remove(tmp);
+		return (-1);
+	}
+
+	if ((flags & HBLK_DURABLE) &&
+	    (rename(tmp, path) != 0 || hblk_sync_dir(path) != 0))
+		return (-1);
+
+	return (0);
+}
@@ -0,0 +1,85 @@
+#include "blockchain.h"
+
+/**
+ * hblk_writer_init - program that sets up the encoders of a .hblk writer
+ *
+ * a deflate stream is created with HBLK_ZLIB, and a payload store with
+ * HBLK_DEDUP
+ *
+ * @writer: the state of the stream to write; its flags member must be set
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_writer_init(hblk_writer_t *writer)
+{
+	writer->zstream = writer->flags & HBLK_ZLIB ?
+		hblk_zstream_create(1) : NULL;
+	writer->payloads = writer->flags & HBLK_DEDUP ?
+		payload_store_create() : NULL;
+
+	return ((!(writer->flags & HBLK_ZLIB) || writer->zstream) &&
+		(!(writer->flags & HBLK_DEDUP) || writer->payloads) ? 0 : -1);
+}
+
+
+
+/**
+ * hblk_writer_clear - program that releases the encoders of a .hblk writer
+ *
+ * @writer: the state of the stream written
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_writer_clear(hblk_writer_t *writer)
+{
+	hblk_zstream_destroy(writer->zstream, 1);
+	payload_store_destroy(writer->payloads);
+	writer->zstream = NULL;
+	writer->payloads = NULL;
+}
+
+
+
+/**
+ * hblk_write_header - program that writes the header of a .hblk file
+ *
+ * the header holds the magic number, the format version, the endianness
+ * and the number of blocks; the format revision tells whether records
+ * carry a CRC32C (HBLK_CRC32C), compressed payloads (HBLK_ZLIB),
+ * deduplicated payloads (HBLK_DEDUP) and header-only records of pruned
+ * blocks (HBLK_PRUNED); with HBLK_CRC32C, the header is followed by its
+ * CRC32C
+ *
+ * @writer: the state of the file being written
+ * @num_blocks: the number of blocks of the blockchain
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_write_header(hblk_writer_t *writer, uint32_t num_blocks)
+{
+	uint8_t header[sizeof(HBLK_MAG) - 1 + sizeof(HBLK_VER) - 1 + 1 + 4];
+	unsigned int flags = writer->flags;
+	uint32_t crc;
+
+	memcpy(header, HBLK_MAG, sizeof(HBLK_MAG) - 1);
+	memcpy(header + 4, HBLK_VER, sizeof(HBLK_VER) - 1);
+	header[6] += (flags & HBLK_CRC32C ? HBLK_REV_CRC32C : 0) +
+		(flags & HBLK_ZLIB ? HBLK_REV_ZLIB : 0) +
+		(flags & HBLK_DEDUP ? HBLK_REV_DEDUP : 0) +
+		(flags & HBLK_PRUNED ? HBLK_REV_PRUNED : 0);
+	header[7] = _get_endianness();
+	memcpy(header + 8, &num_blocks, sizeof(num_blocks));
+
+	fwrite(header, sizeof(header), 1, writer->file);
+	HBLK_STAT_ADD(HBLK_STAT_WRITE_BYTES, sizeof(header) +
+		      (flags & HBLK_CRC32C ? sizeof(crc) : 0));
+
+	if (flags & HBLK_CRC32C)
+	{
+		crc = crc32c(0, header, sizeof(header));
+		fwrite(&crc, sizeof(crc), 1, writer->file);
+	}
+}
@@ -0,0 +1,128 @@
+#include "blockchain.h"
+
+/**
+ * hblk_zstream_create - program that creates the deflate or inflate stream
+ * of the payloads of a .hblk file
+ *
+ * payloads are raw deflate streams, without zlib header nor checksum: they
+ * are at most BLOCKCHAIN_DATA_MAX bytes long, and covered by the record
+ * CRC32C when there is one; the stream is reset, not recreated, for every
+ * payload, and its window and hash table are sized for such payloads, as
+ * resetting a default deflate stream costs more than compressing them
+ *
+ * @deflating: 1 to create a deflate stream, 0 to create an inflate stream
+ *
+ * Return: a pointer to the created stream, or NULL on failure
+ */
+
+z_stream *hblk_zstream_create(int deflating)
+{
+	z_stream *zstream = calloc(1, sizeof(*zstream));
+	int err;
+
+	if (!zstream)
+		return (NULL);
+
+	if (deflating)
+		err = deflateInit2(zstream, HBLK_Z_LEVEL, Z_DEFLATED,
+				   -HBLK_Z_WBITS, HBLK_Z_MEMLEVEL,
+				   Z_DEFAULT_STRATEGY);
+	else
+		err = inflateInit2(zstream, -HBLK_Z_WBITS);
+	if (err != Z_OK)
+	{
+		free(zstream);
+		return (NULL);
+	}
+
+	return (zstream);
+}
+
+
+
+/**
+ * hblk_zstream_destroy - program that destroys a stream created with
+ * hblk_zstream_create()
+ *
+ * @zstream: a pointer to the stream to destroy, may be NULL
+ * @deflating: 1 if it is a deflate stream, 0 if it is an inflate stream
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_zstream_destroy(z_stream *zstream, int deflating)
+{
+	if (!zstream)
+		return;
+
+	if (deflating)
+		deflateEnd(zstream);
+	else
+		inflateEnd(zstream);
+	free(zstream);
+}
+
+
+
+/**
+ * hblk_deflate - program that compresses the payload of a block
+ *
+ * payloads shorter than HBLK_Z_MIN, or that wouldn't shrink, are kept raw
+ * and cost nothing more than in the uncompressed format
+ *
+ * @zstream: a pointer to a deflate stream
+ * @data: a pointer to the payload to compress
+ * @out: a buffer of at least BLOCKCHAIN_DATA_MAX bytes where to store the
+ *       compressed payload
+ *
+ * Return: the stored length of the payload: its length if it is kept raw,
+ *         or the length of the compressed payload with HBLK_Z_BIT set
+ */
+
+uint32_t hblk_deflate(z_stream *zstream, block_data_t const *data,
+		      uint8_t *out)
+{
+	if (data->len < HBLK_Z_MIN || deflateReset(zstream) != Z_OK)
+		return (data->len);
+
+	zstream->next_in = (Bytef *)data->buffer;
+	zstream->avail_in = data->len;
+	zstream->next_out = out;
+	zstream->avail_out = data->len - 1;
+	if (deflate(zstream, Z_FINISH) != Z_STREAM_END)
+		return (data->len);
+
+	return ((uint32_t)zstream->total_out | HBLK_Z_BIT);
+}
+
+
+
+/**
+ * hblk_inflate - program that decompresses the payload of a block
+ *
+ * @zstream: a pointer to an inflate stream
+ * @in: a pointer to the compressed payload
+ * @len: the length of the compressed payload
+ * @data: a pointer to the payload to fill in
+ *
+ * Return: 0 on success, -1 if the compressed payload is invalid, or would
+ *         exceed BLOCKCHAIN_DATA_MAX bytes
+ */
+
+int hblk_inflate(z_stream *zstream, uint8_t const *in, uint32_t len,
+		 block_data_t *data)
+{
+	if (!zstream || inflateReset(zstream) != Z_OK)
+		return (-1);
+
+	zstream->next_in = (Bytef *)in;
+	zstream->avail_in = len;
+	zstream->next_out = (Bytef *)data->buffer;
+	zstream->avail_out = BLOCKCHAIN_DATA_MAX;
+	if (inflate(zstream, Z_FINISH) != Z_STREAM_END || zstream->avail_in)
+		return (-1);
+
+	data->len = (uint32_t)zstream->total_out;
+
+	return (0);
+}
@@ -0,0 +1,154 @@
+#include "blockchain.h"
+
+/**
+ * payload_slot - program that looks up the slot of a payload in a store
+ *
+ * @store: a pointer to the store
+ * @hash: the SHA-256 digest of the payload
+ *
+ * Return: the slot holding the payload, or the free slot where it would
+ *         be inserted
+ */
+
+static uint32_t payload_slot(payload_store_t const *store,
+			     uint8_t const hash[SHA256_DIGEST_LENGTH])
+{
+	uint32_t mask = store->capacity - 1, slot;
+
+	slot = BLOCK_INDEX_KEY(hash) & mask;
+	while (store->slots[slot] &&
+	       memcmp(store->slots[slot]->hash, hash, SHA256_DIGEST_LENGTH))
+		slot = (slot + 1) & mask;
+
+	return (slot);
+}
+
+
+
+/**
+ * store_grow - program that doubles the number of slots of a store
+ *
+ * @store: a pointer to the store
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+static int store_grow(payload_store_t *store)
+{
+	payload_t **slots = store->slots;
+	uint32_t capacity = store->capacity, i;
+
+	store->slots = calloc(capacity * 2, sizeof(*store->slots));
+	if (!store->slots)
+	{
+		store->slots = slots;
+		return (-1);
+	}
+	store->capacity = capacity * 2;
+
+	for (i = 0; i < capacity; i++)
+		if (slots[i])
+			store->slots[payload_slot(store, slots[i]->hash)] = slots[i];
+	free(slots);
+
+	return (0);
+}
+
+
+
+/**
+ * payload_store_create - program that creates an empty payload store
+ *
+ * Return: a pointer to the new store, or NULL on failure
+ */
+
+payload_store_t *payload_store_create(void)
+{
+	payload_store_t *store = calloc(1, sizeof(*store));
+
+	if (!store)
+		return (NULL);
+
+	store->slots = calloc(PAYLOAD_STORE_MIN_SLOTS, sizeof(*store->slots));
+	if (!store->slots)
+	{
+		free(store);
+		return (NULL);
+	}
+	store->capacity = PAYLOAD_STORE_MIN_SLOTS;
+
+	return (store);
+}
+
+
+
+/**
+ * payload_store_destroy - program that frees a payload store
+ *
+ * the store holds no payload, only their digests
+ *
+ * @store: a pointer to the store to free
+ *
+ * Return: nothing (void)
+ */
+
+void payload_store_destroy(payload_store_t *store)
+{
+	uint32_t i;
+
+	if (!store)
+		return;
+
+	for (i = 0; i < store->capacity; i++)
+		free(store->slots[i]);
+	free(store->slots);
+	free(store);
+}
+
+
+
+/**
+ * payload_store_put - program that adds a reference to a payload
+ *
+ * the payload is looked up by its SHA-256 digest: a known payload gets one
+ * more reference, and a new one is added with a single reference
+ *
+ * @store: a pointer to the store
+ * @data: a pointer to the payload; it is only hashed, not kept
+ * @len: the length of the payload
+ * @first: the position of the block carrying the payload, recorded if new
+ *
+ * Return: a pointer to the entry of the payload, whose refs member is
+ *         greater than 1 if it is a duplicate, or NULL on failure
+ */
+
+payload_t *payload_store_put(payload_store_t *store, int8_t const *data,
+			     uint32_t len, uint32_t first)
+{
+	uint8_t hash[SHA256_DIGEST_LENGTH];
+	payload_t **slot;
+
+	if (!store || (!data && len) || !SHA256((unsigned char const *)data,
+						len, hash))
+		return (NULL);
+	if (store->count >= store->capacity / 2 && store_grow(store) != 0)
+		return (NULL);
+
+	slot = &store->slots[payload_slot(store, hash)];
+	if (!*slot)
+	{
+		*slot = calloc(1, sizeof(**slot));
+		if (!*slot)
+			return (NULL);
+		memcpy((*slot)->hash, hash, SHA256_DIGEST_LENGTH);
+		(*slot)->len = len;
+		(*slot)->first = first;
+		store->count++;
+		store->unique_bytes += len;
+	}
+	(*slot)->refs++;
+	store->refs++;
+	store->bytes += len;
+
+	return (*slot);
+}
@@ -0,0 +1,114 @@
+#include "blockchain.h"
+
+/**
+ * payload_store_release - program that drops a reference to a payload
+ *
+ * the entry of a payload left without references is removed; the entries
+ * following it in its probe sequence are shifted back, so lookups never
+ * stop early on the freed slot
+ *
+ * @store: a pointer to the store
+ * @payload: a pointer to the entry returned by payload_store_put()
+ *
+ * Return: nothing (void)
+ */
+
+void payload_store_release(payload_store_t *store, payload_t *payload)
+{
+	uint32_t mask, hole, slot, home;
+
+	if (!store || !payload || !payload->refs)
+		return;
+
+	store->refs--;
+	store->bytes -= payload->len;
+	if (--payload->refs)
+		return;
+
+	mask = store->capacity - 1;
+	hole = BLOCK_INDEX_KEY(payload->hash) & mask;
+	while (store->slots[hole] != payload)
+		hole = (hole + 1) & mask;
+	store->slots[hole] = NULL;
+	store->count--;
+	store->unique_bytes -= payload->len;
+	free(payload);
+
+	for (slot = (hole + 1) & mask; store->slots[slot];
+	     slot = (slot + 1) & mask)
+	{
+		home = BLOCK_INDEX_KEY(store->slots[slot]->hash) & mask;
+		if (((slot - home) & mask) < ((slot - hole) & mask))
+			continue;
+		store->slots[hole] = store->slots[slot];
+		store->slots[slot] = NULL;
+		hole = slot;
+	}
+}
+
+
+
+/**
+ * payload_store_print - program that prints the deduplication report of
+ * a payload store
+ *
+ * @store: a pointer to the store
+ *
+ * Return: nothing (void)
+ */
+
+void payload_store_print(payload_store_t const *store)
+{
+	if (!store)
+		return;
+
+	printf("Payloads: %u, distinct: %u, dedup ratio: %.2f\n",
+	       store->refs, store->count,
+	       store->unique_bytes ?
+	       (double)store->bytes / store->unique_bytes : 1.);
+	printf("Bytes: %lu, distinct: %lu, saved: %lu (%.1f%%)\n",
+	       (unsigned long)store->bytes, (unsigned long)store->unique_bytes,
+	       (unsigned long)(store->bytes - store->unique_bytes),
+	       store->bytes ? 100. * (store->bytes - store->unique_bytes) /
+	       store->bytes : 0.);
+}
+
+
+
+/**
+ * blockchain_payloads - program that builds the payload store of the
+ * active chain of a blockchain
+ *
+ * every payload of at least HBLK_DEDUP_MIN bytes is referenced, so the
+ * store tells how much deduplication would save
+ *
+ * @blockchain: a pointer to the blockchain
+ *
+ * Return: a pointer to the new store, or NULL on failure
+ */
+
+payload_store_t *blockchain_payloads(blockchain_t const *blockchain)
+{
+	payload_store_t *store;
+	chain_cursor_t cursor;
+	block_t const *block;
+	uint32_t pos;
+
+	if (!blockchain || chain_cursor_open(&cursor, blockchain) != 0)
+		return (NULL);
+
+	store = payload_store_create();
+	for (pos = 0; store && (block = chain_cursor_next(&cursor)); pos++)
+	{
+		if (block->data.len >= HBLK_DEDUP_MIN &&
+		    !payload_store_put(store, block->data.buffer,
+				       block->data.len, pos))
+		{
+			payload_store_destroy(store);
+			store = NULL;
+		}
+	}
+	chain_cursor_close(&cursor);
+
+	return (store);
+}
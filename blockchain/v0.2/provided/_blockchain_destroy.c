@@ -13,6 +13,9 @@ void _blockchain_destroy(blockchain_t *blockchain)
 		return;
 
 	llist_destroy(blockchain->chain, 1, (node_dtor_t)free);
+	block_index_clear(&blockchain->by_hash);
+	time_index_clear(&blockchain->by_time);
+	chain_view_destroy(blockchain->view);
 
 	free(blockchain);
 }
\ No newline at end of file
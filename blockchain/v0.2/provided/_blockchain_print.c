@@ -104,6 +104,33 @@ static int _block_print_brief(block_t const *block, unsigned int index,
 	return (0);
 }
 
+/**
+ * _blockchain_print_blocks - Prints every Block of a Blockchain
+ *
+ * @blockchain: Pointer to the Blockchain to be printed
+ * @print:      Function used to print a single Block
+ */
+static void _blockchain_print_blocks(blockchain_t const *blockchain,
+				     int (*print)(block_t const *,
+						  unsigned int, char const *))
+{
+	block_t const *batch[CHAIN_CURSOR_BATCH];
+	chain_cursor_t cursor;
+	unsigned int count, i, index = 0;
+
+	if (chain_cursor_open(&cursor, blockchain) != 0)
+		return;
+
+	while ((count = chain_cursor_batch(&cursor, batch,
+					   CHAIN_CURSOR_BATCH)) != 0)
+	{
+		for (i = 0; i < count; i++)
+			print(batch[i], index++, "\t\t");
+	}
+
+	chain_cursor_close(&cursor);
+}
+
 /**
  * _blockchain_print - Prints an entire Blockchain
  *
@@ -114,8 +141,7 @@ void _blockchain_print(blockchain_t const *blockchain)
 	printf("Blockchain: {\n");
 
 	printf("\tchain [%d]: [\n", llist_size(blockchain->chain));
-	llist_for_each(blockchain->chain,
-		       (node_func_t)_block_print, "\t\t");
+	_blockchain_print_blocks(blockchain, _block_print);
 	printf("\t]\n");
 
 	printf("}\n");
@@ -132,8 +158,7 @@ void _blockchain_print_brief(blockchain_t const *blockchain)
 	printf("Blockchain: {\n");
 
 	printf("\tchain [%d]: [\n", llist_size(blockchain->chain));
-	llist_for_each(blockchain->chain,
-		       (node_func_t)_block_print_brief, "\t\t");
+	_blockchain_print_blocks(blockchain, _block_print_brief);
 	printf("\t]\n");
 
 	printf("}\n");
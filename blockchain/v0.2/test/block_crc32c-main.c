@@ -0,0 +1,93 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	100000
+
+/**
+ * _load - Loads a Blockchain and times it
+ *
+ * @path:  Path to the file to load
+ * @flags: Deserialization flags
+ */
+static void _load(char const *path, unsigned int flags)
+{
+	struct timespec start, end;
+	blockchain_t *blockchain;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	blockchain = blockchain_deserialize_flags(path, flags);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	printf("%s%s: [%d] in %.3f ms\n", path,
+	       flags & HBLK_VERIFY ? " (verify)" : "",
+	       blockchain ? llist_size(blockchain->chain) : -1,
+	       (end.tv_sec - start.tv_sec) * 1e3 +
+	       (end.tv_nsec - start.tv_nsec) / 1e6);
+	blockchain_destroy(blockchain);
+}
+
+/**
+ * _corrupt - Flips a bit at a given offset of a file
+ *
+ * @path:   Path to the file to corrupt
+ * @offset: Offset of the byte to corrupt
+ */
+static void _corrupt(char const *path, long offset)
+{
+	FILE *file = fopen(path, "r+b");
+	int c;
+
+	fseek(file, offset, SEEK_SET);
+	c = fgetc(file);
+	fseek(file, offset, SEEK_SET);
+	fputc(c ^ 0x10, file);
+	fclose(file);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block;
+	int i;
+
+	printf("crc32c(\"123456789\"): %08x\n", crc32c(0, "123456789", 9));
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton School",
+				     1 + i % 16);
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+	blockchain_serialize(blockchain, "plain.hblk");
+	blockchain_serialize_flags(blockchain, "crc.hblk", HBLK_CRC32C);
+	blockchain_destroy(blockchain);
+
+	_load("plain.hblk", 0);
+	_load("plain.hblk", HBLK_VERIFY);
+	_load("crc.hblk", 0);
+	_load("crc.hblk", HBLK_VERIFY);
+
+	/* Corrupt the nonce of the first Block after the Genesis Block */
+	_corrupt("crc.hblk", 16 + 56 + 4 + 16 + 32 + 4 + 16);
+	_load("crc.hblk", 0);
+	/* Restore it, and corrupt its CRC instead: the hash still matches */
+	_corrupt("crc.hblk", 16 + 56 + 4 + 16 + 32 + 4 + 16);
+	_corrupt("crc.hblk", 16 + 56 + 4 + 16 + 32 + 4 + 56 + 4 + 1 + 32);
+	_load("crc.hblk", 0);
+	/* Corrupt the header */
+	_corrupt("crc.hblk", 8);
+	_load("crc.hblk", 0);
+
+	return (EXIT_SUCCESS);
+}
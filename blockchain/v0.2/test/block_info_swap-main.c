@@ -0,0 +1,131 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	200000
+
+/**
+ * _write_foreign - Serializes a Blockchain with the opposite endianness
+ *
+ * @blockchain: Pointer to the Blockchain to serialize
+ * @path:       Path to the file to write
+ */
+static void _write_foreign(blockchain_t const *blockchain, char const *path)
+{
+	FILE *file = fopen(path, "wb");
+	block_t const *block;
+	block_info_t info;
+	chain_cursor_t cursor;
+	uint8_t endian = _get_endianness() == 1 ? 2 : 1;
+	uint32_t num_blocks = llist_size(blockchain->chain), len;
+
+	SWAPENDIAN(num_blocks);
+	fwrite(HBLK_MAG HBLK_VER, 1, 7, file);
+	fwrite(&endian, 1, 1, file);
+	fwrite(&num_blocks, 4, 1, file);
+
+	chain_cursor_open(&cursor, blockchain);
+	while ((block = chain_cursor_next(&cursor)) != NULL)
+	{
+		info = block->info;
+		SWAPENDIAN(info.index);
+		SWAPENDIAN(info.difficulty);
+		SWAPENDIAN(info.timestamp);
+		SWAPENDIAN(info.nonce);
+		len = block->data.len;
+		SWAPENDIAN(len);
+		fwrite(&info, sizeof(info), 1, file);
+		fwrite(&len, 4, 1, file);
+		fwrite(block->data.buffer, 1, block->data.len, file);
+		fwrite(block->hash, 1, SHA256_DIGEST_LENGTH, file);
+	}
+	chain_cursor_close(&cursor);
+	fclose(file);
+}
+
+/**
+ * _load - Loads a Blockchain and times it
+ *
+ * @path: Path to the file to load
+ *
+ * Return: Pointer to the loaded Blockchain
+ */
+static blockchain_t *_load(char const *path)
+{
+	struct timespec start, end;
+	blockchain_t *blockchain;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	blockchain = blockchain_deserialize(path);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	printf("%s: [%d] in %.3f ms\n", path,
+	       blockchain ? llist_size(blockchain->chain) : -1,
+	       (end.tv_sec - start.tv_sec) * 1e3 +
+	       (end.tv_nsec - start.tv_nsec) / 1e6);
+
+	return (blockchain);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain, *native, *foreign;
+	block_t const genesis = GENESIS_BLOCK;
+	block_t *block;
+	block_t const *a, *b;
+	block_info_t info, swapped;
+	chain_cursor_t cursor;
+	int i;
+
+	info = genesis.info;
+	info.nonce = 0x0102030405060708;
+	swapped = info;
+	block_info_swap(&swapped, 1);
+	SWAPENDIAN(info.index);
+	SWAPENDIAN(info.difficulty);
+	SWAPENDIAN(info.timestamp);
+	SWAPENDIAN(info.nonce);
+	printf("block_info_swap: %s\n",
+	       memcmp(&info, &swapped, sizeof(info)) ? "KO" : "OK");
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton School",
+				     1 + i % 16);
+		block->info.nonce = i;
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+	blockchain_serialize(blockchain, "native.hblk");
+	_write_foreign(blockchain, "foreign.hblk");
+	blockchain_destroy(blockchain);
+
+	native = _load("native.hblk");
+	foreign = _load("foreign.hblk");
+	chain_cursor_open(&cursor, native);
+	while ((a = chain_cursor_next(&cursor)) != NULL)
+	{
+		b = blockchain_get_by_hash(foreign, a->hash);
+		if (!b || memcmp(a, b, sizeof(*a)))
+		{
+			fprintf(stderr, "Block %u differs\n", a->info.index);
+			return (EXIT_FAILURE);
+		}
+	}
+	chain_cursor_close(&cursor);
+	printf("Both chains are identical\n");
+
+	blockchain_destroy(native);
+	blockchain_destroy(foreign);
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "blockchain.h"
+
+#define NB_MINERS	4
+#define NB_BLOCKS	32
+
+/**
+ * struct miner_s - Miner thread context
+ *
+ * @blockchain: Pointer to the Blockchain to mine on
+ * @queue:      Pointer to the queue to submit solved Blocks to
+ * @solved:     Number of Blocks solved
+ * @dropped:    Number of Blocks dropped because the queue was full
+ */
+typedef struct miner_s
+{
+	blockchain_t *blockchain;
+	block_queue_t *queue;
+	unsigned long solved;
+	unsigned long dropped;
+} miner_t;
+
+static atomic_int done;
+
+/**
+ * _miner - Miner thread: mines Blocks on top of the current tip
+ *
+ * @arg: Pointer to the miner context
+ *
+ * Return: NULL
+ */
+static void *_miner(void *arg)
+{
+	miner_t *m = (miner_t *)arg;
+	chain_snapshot_t snap;
+	block_t *block;
+	int id = chain_view_reader(m->blockchain->view);
+
+	while (!atomic_load(&done))
+	{
+		chain_view_snapshot(m->blockchain->view, id, &snap);
+		block = block_create(snap.blocks[snap.size - 1],
+				     (int8_t *)"Holberton", 9);
+		chain_view_release(m->blockchain->view, id);
+
+		block->info.difficulty = 12;
+		block->info.nonce = (uint64_t)rand() << 32;
+		block_mine(block);
+		m->solved++;
+		if (block_queue_push(m->queue, block) != 0)
+		{
+			m->dropped++;
+			block_destroy(block);
+		}
+	}
+
+	return (NULL);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_queue_t *queue;
+	pthread_t threads[NB_MINERS];
+	miner_t miners[NB_MINERS];
+	unsigned long solved = 0;
+	int i, appended = 0;
+
+	blockchain = blockchain_create();
+	blockchain_view_enable(blockchain);
+	queue = block_queue_create(16);
+
+	for (i = 0; i < NB_MINERS; i++)
+	{
+		memset(&miners[i], 0, sizeof(miners[i]));
+		miners[i].blockchain = blockchain;
+		miners[i].queue = queue;
+		pthread_create(&threads[i], NULL, _miner, &miners[i]);
+	}
+	while (appended < NB_BLOCKS)
+		appended += blockchain_drain(blockchain, queue);
+	atomic_store(&done, 1);
+	for (i = 0; i < NB_MINERS; i++)
+	{
+		pthread_join(threads[i], NULL);
+		solved += miners[i].solved;
+	}
+	blockchain_drain(blockchain, queue);
+
+	printf("Chain [%d]: %lu Blocks solved\n",
+	       llist_size(blockchain->chain), solved);
+	for (i = 1; i < llist_size(blockchain->chain); i++)
+	{
+		if (block_is_valid(llist_get_node_at(blockchain->chain, i),
+				   llist_get_node_at(blockchain->chain, i - 1)))
+		{
+			fprintf(stderr, "Invalid Block at %d\n", i);
+			return (EXIT_FAILURE);
+		}
+	}
+	printf("All Blocks valid\n");
+
+	block_queue_destroy(queue);
+	blockchain_destroy(blockchain);
+
+	return (EXIT_SUCCESS);
+}
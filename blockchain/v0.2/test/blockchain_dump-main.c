@@ -0,0 +1,149 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	1000000
+
+void _blockchain_print_brief(blockchain_t const *blockchain);
+
+/**
+ * _elapsed - Computes the time elapsed since a given time
+ *
+ * @start: Start time
+ *
+ * Return: the elapsed time, in milliseconds
+ */
+static double _elapsed(struct timespec const *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return ((end.tv_sec - start->tv_sec) * 1e3 +
+		(end.tv_nsec - start->tv_nsec) / 1e6);
+}
+
+/**
+ * _build - Builds a Blockchain with fixed timestamps
+ *
+ * @n: Number of Blocks to add after the Genesis Block
+ *
+ * Return: a pointer to the Blockchain
+ */
+static blockchain_t *_build(uint32_t n)
+{
+	blockchain_t *blockchain = blockchain_create();
+	block_t *block = llist_get_head(blockchain->chain);
+	char data[32];
+	uint32_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		sprintf(data, "Holberton %u", i);
+		block = block_create(block, (int8_t *)data, strlen(data));
+		block->info.timestamp = 1537578000 + i;
+		block->info.nonce = i * 2654435761U;
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+
+	return (blockchain);
+}
+
+/**
+ * _print_to - Runs _blockchain_print_brief() with stdout redirected
+ *
+ * @blockchain: Blockchain to print
+ * @path:       Path stdout is redirected to
+ */
+static void _print_to(blockchain_t const *blockchain, char const *path)
+{
+	int saved = dup(STDOUT_FILENO), fd;
+
+	fflush(stdout);
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	dup2(fd, STDOUT_FILENO);
+	close(fd);
+	_blockchain_print_brief(blockchain);
+	fflush(stdout);
+	dup2(saved, STDOUT_FILENO);
+	close(saved);
+}
+
+/**
+ * _same_files - Compares the contents of two files
+ *
+ * @a: Path to the first file
+ * @b: Path to the second file
+ *
+ * Return: 1 if both files hold the same bytes, 0 otherwise
+ */
+static int _same_files(char const *a, char const *b)
+{
+	FILE *fa = fopen(a, "rb"), *fb = fopen(b, "rb");
+	int ca, cb, same = fa && fb;
+
+	do {
+		ca = same ? fgetc(fa) : EOF;
+		cb = same ? fgetc(fb) : EOF;
+		same = same && ca == cb;
+	} while (same && ca != EOF);
+	if (fa)
+		fclose(fa);
+	if (fb)
+		fclose(fb);
+
+	return (same);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	struct timespec start;
+	double print_ms, dump_ms;
+	int fd;
+
+	blockchain = _build(2);
+	fd = open("dump.txt", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	printf("Dump: %d\n", blockchain_dump(blockchain, fd, HBLK_DUMP_TEXT));
+	close(fd);
+	_print_to(blockchain, "print.txt");
+	printf("Same as _blockchain_print_brief(): %d\n",
+	       _same_files("dump.txt", "print.txt"));
+	remove("dump.txt");
+	remove("print.txt");
+	fflush(stdout);
+	blockchain_dump(blockchain, STDOUT_FILENO, HBLK_DUMP_JSON);
+	blockchain_dump(blockchain, STDOUT_FILENO, HBLK_DUMP_CSV);
+	printf("Invalid format: %d\n", blockchain_dump(blockchain, 1, 3));
+	printf("Invalid fd: %d\n", blockchain_dump(blockchain, -1, 0));
+	blockchain_destroy(blockchain);
+
+	blockchain = _build(NB_BLOCKS);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	_print_to(blockchain, "/dev/null");
+	print_ms = _elapsed(&start);
+	fd = open("/dev/null", O_WRONLY);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	blockchain_dump(blockchain, fd, HBLK_DUMP_TEXT);
+	dump_ms = _elapsed(&start);
+	printf("Text: %.0f ms (printer), %.0f ms (dump), %.1fx\n", print_ms,
+	       dump_ms, print_ms / dump_ms);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	blockchain_dump(blockchain, fd, HBLK_DUMP_JSON);
+	printf("JSON: %.0f ms\n", _elapsed(&start));
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	blockchain_dump(blockchain, fd, HBLK_DUMP_CSV);
+	printf("CSV: %.0f ms\n", _elapsed(&start));
+	close(fd);
+
+	blockchain_destroy(blockchain);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,136 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	1000000
+
+/**
+ * _elapsed - Computes the time elapsed since a given time
+ *
+ * @start: Start time
+ *
+ * Return: the elapsed time, in milliseconds
+ */
+static double _elapsed(struct timespec const *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return ((end.tv_sec - start->tv_sec) * 1e3 +
+		(end.tv_nsec - start->tv_nsec) / 1e6);
+}
+
+/**
+ * _validate - Validates every Block of a Blockchain
+ *
+ * @blockchain: Blockchain to validate
+ * @max:        Address at which to store the highest difficulty
+ *
+ * Return: the number of invalid Blocks
+ */
+static uint32_t _validate(blockchain_t const *blockchain, uint32_t *max)
+{
+	chain_cursor_t cursor;
+	block_t const *block, *prev = NULL;
+	uint32_t invalid = 0;
+
+	*max = 0;
+	chain_cursor_open(&cursor, blockchain);
+	while ((block = chain_cursor_next(&cursor)) != NULL)
+	{
+		invalid += block_is_valid(block, prev) != 0 ||
+			!hash_matches_difficulty(block->hash,
+						 block->info.difficulty);
+		*max = block->info.difficulty > *max ?
+			block->info.difficulty : *max;
+		prev = block;
+	}
+	chain_cursor_close(&cursor);
+
+	return (invalid);
+}
+
+/**
+ * _same_files - Compares the contents of two files
+ *
+ * @a: Path to the first file
+ * @b: Path to the second file
+ *
+ * Return: 1 if both files hold the same bytes, 0 otherwise
+ */
+static int _same_files(char const *a, char const *b)
+{
+	FILE *fa = fopen(a, "rb"), *fb = fopen(b, "rb");
+	int ca, cb, same = fa && fb;
+
+	do {
+		ca = same ? fgetc(fa) : EOF;
+		cb = same ? fgetc(fb) : EOF;
+		same = same && ca == cb;
+	} while (same && ca != EOF);
+	if (fa)
+		fclose(fa);
+	if (fb)
+		fclose(fb);
+
+	return (same);
+}
+
+/**
+ * main - Entry point
+ *
+ * Usage: blockchain_generate [count [path]]
+ *
+ * @ac: Arguments count
+ * @av: Arguments vector
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(int ac, char **av)
+{
+	hblk_gen_t gen = {200, 42, 16, 256, HBLK_GEN_SKEWED, 25,
+		HBLK_GEN_ADJUST, 1, 12, 0, 0, 0, 0, 1};
+	char const *path = ac > 2 ? av[2] : "gen.hblk";
+	blockchain_t *blockchain;
+	struct timespec start;
+	uint32_t max;
+
+	/* Blocks come too fast: the difficulty rises up to its limit */
+	blockchain = blockchain_generate(&gen);
+	printf("Mined: [%d] Blocks, invalid: [%u]",
+	       llist_size(blockchain->chain), _validate(blockchain, &max));
+	printf(", highest difficulty: [%u]\n", max);
+	blockchain_serialize_flags(blockchain, "mem.hblk", HBLK_CRC32C);
+	hblk_generate("gen.hblk", &gen, HBLK_CRC32C);
+	printf("Same as in memory: %d\n", _same_files("mem.hblk", "gen.hblk"));
+	blockchain_destroy(blockchain);
+	remove("mem.hblk");
+
+	gen.profile = HBLK_GEN_RAMP;
+	printf("Invalid ramp: %p\n", (void *)blockchain_generate(&gen));
+
+	/* Difficulty 0: production scale in seconds */
+	gen.profile = HBLK_GEN_FLAT;
+	gen.count = ac > 1 ? (uint32_t)atoi(av[1]) : NB_BLOCKS;
+	gen.mine = 0;
+	gen.interval = 1;
+	gen.jitter = 1;
+	gen.data_max = BLOCKCHAIN_DATA_MAX;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	printf("Generate: %d", hblk_generate(path, &gen, HBLK_CRC32C));
+	printf(" (%.0f ms)\n", _elapsed(&start));
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	blockchain = blockchain_deserialize(path);
+	printf("Loaded: [%d] Blocks (%.0f ms)\n",
+	       blockchain ? llist_size(blockchain->chain) : -1,
+	       _elapsed(&start));
+	printf("Invalid: [%u]\n", _validate(blockchain, &max));
+	blockchain_destroy(blockchain);
+	if (ac < 3)
+		remove(path);
+
+	return (EXIT_SUCCESS);
+}
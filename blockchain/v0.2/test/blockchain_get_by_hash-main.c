@@ -0,0 +1,85 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+/**
+ * _print_hex_buffer - Prints a buffer in its hexadecimal form
+ *
+ * @buf: Pointer to the buffer to be printed
+ * @len: Number of bytes from @buf to be printed
+ */
+static void _print_hex_buffer(uint8_t const *buf, size_t len)
+{
+	size_t i;
+
+	for (i = 0; buf && i < len; i++)
+		printf("%02x", buf[i]);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block, *found;
+	uint8_t unknown[SHA256_DIGEST_LENGTH] = {0};
+	char data[32];
+	int i;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+
+	/* Enough blocks to grow the index a few times */
+	for (i = 0; i < 200; i++)
+	{
+		sprintf(data, "Block %d", i + 1);
+		block = block_create(block, (int8_t *)data, strlen(data));
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+
+	/* Walk the chain backwards, from the tip to the Genesis Block */
+	for (i = 0; block->info.index != 0; i++)
+		block = blockchain_get_by_hash(blockchain, block->info.prev_hash);
+	printf("Reached Genesis Block in %d lookups: ", i);
+	_print_hex_buffer(block->hash, SHA256_DIGEST_LENGTH);
+	printf("\n");
+
+	for (i = 0; i < llist_size(blockchain->chain); i++)
+	{
+		block = llist_get_node_at(blockchain->chain, i);
+		found = blockchain_get_by_hash(blockchain, block->hash);
+		if (found != block)
+		{
+			fprintf(stderr, "Block %d not found by hash\n", i);
+			return (EXIT_FAILURE);
+		}
+	}
+	printf("All %d Blocks found by hash\n", i);
+
+	/* A duplicate is rejected, and the chain keeps appending after it */
+	block = llist_get_tail(blockchain->chain);
+	found = malloc(sizeof(*found));
+	memcpy(found, block, sizeof(*found));
+	printf("Duplicate Block: %d\n", blockchain_add_block(blockchain, found));
+	free(found);
+	block = block_create(block, (int8_t *)"Holberton", 9);
+	block_hash(block, block->hash);
+	blockchain_add_block(blockchain, block);
+	printf("Chain [%d], tail is the new Block: %d\n",
+	       llist_size(blockchain->chain),
+	       llist_get_tail(blockchain->chain) == block &&
+	       llist_get_node_at(blockchain->chain, 201) == block);
+
+	found = blockchain_get_by_hash(blockchain, unknown);
+	printf("Unknown hash: %p\n", (void *)found);
+
+	blockchain_destroy(blockchain);
+
+	return (EXIT_SUCCESS);
+}
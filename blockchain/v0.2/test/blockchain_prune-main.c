@@ -0,0 +1,154 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	2000
+#define DEPTH		100
+
+/**
+ * _size - Computes the size of a file
+ *
+ * @path: Path to the file
+ *
+ * Return: the size of the file, in bytes
+ */
+static long _size(char const *path)
+{
+	struct stat st;
+
+	return (stat(path, &st) == 0 ? (long)st.st_size : -1);
+}
+
+/**
+ * _mine - Mines a Block on top of another one
+ *
+ * @prev: Previous Block
+ * @data: Payload
+ *
+ * Return: the mined Block
+ */
+static block_t *_mine(block_t const *prev, char const *data)
+{
+	block_t *block = block_create(prev, (int8_t *)data, strlen(data));
+
+	block_hash(block, block->hash);
+	return (block);
+}
+
+/**
+ * _hold - Holds a snapshot until the main thread releases it
+ *
+ * @written: Number of Blocks written so far
+ * @total:   Number of Blocks to write
+ * @arg:     Mutex held by the main thread
+ */
+static void _hold(uint32_t written, uint32_t total, void *arg)
+{
+	(void)written;
+	(void)total;
+	pthread_mutex_lock((pthread_mutex_t *)arg);
+	pthread_mutex_unlock((pthread_mutex_t *)arg);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain, *loaded;
+	block_t *block, *fork, *deep, copy;
+	hblk_store_t *store;
+	chain_cursor_t cursor;
+	block_t const *b;
+	hblk_snapshot_t *snapshot;
+	pthread_mutex_t hold = PTHREAD_MUTEX_INITIALIZER;
+	char header[8];
+	FILE *file;
+	int i;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = _mine(block, "Holberton School, a payload nobody reads");
+		blockchain_add_block(blockchain, block);
+	}
+	deep = llist_get_node_at(blockchain->chain, 10);
+	blockchain_serialize(blockchain, "full.hblk");
+
+	/* Blocks being written by a snapshot are not pruned under it */
+	pthread_mutex_lock(&hold);
+	snapshot = blockchain_snapshot_async(blockchain, "snapshot.hblk", 0,
+					     _hold, NULL, &hold);
+	printf("Pruned during snapshot: %d\n",
+	       blockchain_prune(blockchain, DEPTH));
+	pthread_mutex_unlock(&hold);
+	printf("Snapshot: %d\n", hblk_snapshot_wait(snapshot));
+	remove("snapshot.hblk");
+
+	printf("Pruned: %d\n", blockchain_prune(blockchain, DEPTH));
+	printf("Pruned again: %d\n", blockchain_prune(blockchain, DEPTH));
+	printf("Block #10: len %u, Block #%d: len %u\n",
+	       deep->data.len, NB_BLOCKS - DEPTH,
+	       ((block_t *)llist_get_node_at(blockchain->chain,
+					     NB_BLOCKS - DEPTH))->data.len);
+
+	/* Linkage and difficulty still work on top of a pruned chain */
+	block = _mine(llist_get_tail(blockchain->chain), "New Block");
+	printf("New Block valid: %s\n",
+	       block_is_valid(block, llist_get_tail(blockchain->chain)) ?
+	       "no" : "yes");
+	blockchain_add_block(blockchain, block);
+	/* A fork below the pruned Blocks is rejected */
+	fork = _mine(deep, "Fork");
+	printf("Deep fork: %d\n", blockchain_tree_add(blockchain, fork));
+	free(fork);
+
+	blockchain_serialize_flags(blockchain, "pruned.hblk", HBLK_CRC32C);
+	printf("Full: %ld bytes, pruned: %ld bytes\n", _size("full.hblk"),
+	       _size("pruned.hblk"));
+	loaded = blockchain_deserialize_flags("pruned.hblk", HBLK_VERIFY);
+	printf("Loaded [%d], pruned up to #%u\n",
+	       loaded ? llist_size(loaded->chain) : -1,
+	       loaded ? loaded->pruned : 0);
+	blockchain_destroy(loaded);
+
+	/* Header-only records are flagged in the revision, even without flags */
+	blockchain_serialize(blockchain, "pruned0.hblk");
+	file = fopen("pruned0.hblk", "rb");
+	fread(header, 1, sizeof(header), file);
+	fclose(file);
+	loaded = blockchain_deserialize("pruned0.hblk");
+	printf("Revision: %.3s, loaded [%d]\n", header + 4,
+	       loaded ? llist_size(loaded->chain) : -1);
+	blockchain_destroy(loaded);
+	remove("full.hblk");
+	remove("pruned.hblk");
+	remove("pruned0.hblk");
+
+	system("rm -rf prune.d");
+	store = hblk_store_open("prune.d", 256);
+	chain_cursor_open(&cursor, blockchain);
+	while ((b = chain_cursor_next(&cursor)) != NULL)
+		hblk_store_append(store, b);
+	chain_cursor_close(&cursor);
+	printf("Segments pruned: %d\n", hblk_store_prune(store, DEPTH));
+	hblk_store_close(store);
+	store = hblk_store_open("prune.d", 256);
+	printf("Reopened [%u], Block #300: len %u\n", hblk_store_size(store),
+	       hblk_store_get(store, 300, &copy) == 0 ? copy.data.len : 0);
+	printf("Block #%d: len %u\n", NB_BLOCKS - DEPTH,
+	       hblk_store_get(store, NB_BLOCKS - DEPTH, &copy) == 0 ?
+	       copy.data.len : 0);
+	hblk_store_close(store);
+	fflush(stdout);
+	system("du -sb prune.d | cut -f1; rm -rf prune.d");
+
+	blockchain_destroy(blockchain);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,139 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	200000
+#define START		1700000000
+
+/**
+ * _scan - Counts the Blocks within a time range by scanning the chain
+ *
+ * @blockchain: Pointer to the Blockchain
+ * @from:       Start of the range
+ * @to:         End of the range
+ *
+ * Return: the number of Blocks within the range
+ */
+static uint32_t _scan(blockchain_t const *blockchain, uint64_t from,
+		      uint64_t to)
+{
+	chain_cursor_t cursor;
+	block_t const *block;
+	uint32_t count = 0;
+
+	chain_cursor_open(&cursor, blockchain);
+	while ((block = chain_cursor_next(&cursor)) != NULL)
+		count += block->info.timestamp >= from &&
+			block->info.timestamp <= to;
+	chain_cursor_close(&cursor);
+
+	return (count);
+}
+
+/**
+ * _elapsed - Computes the time elapsed since a given time
+ *
+ * @start: Start time
+ *
+ * Return: the elapsed time, in microseconds
+ */
+static double _elapsed(struct timespec const *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return ((end.tv_sec - start->tv_sec) * 1e6 +
+		(end.tv_nsec - start->tv_nsec) / 1e3);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain, *loaded;
+	time_entry_t const *range;
+	struct timespec start;
+	uint32_t count, i, sorted = 1;
+	block_t *block, *tip;
+	double index_us, scan_us;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton", 9);
+		/* Near-monotonic: every 7th Block is a bit late */
+		block->info.timestamp = START + i - (i % 7 ? 0 : 3);
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	range = blockchain_range_by_time(blockchain, START + 1000, START + 1999,
+					 &count);
+	index_us = _elapsed(&start);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	i = _scan(blockchain, START + 1000, START + 1999);
+	scan_us = _elapsed(&start);
+	printf("Range: [%u] Blocks, scan: [%u]\n", count, i);
+	printf("Index faster than scan: %s (%.1f us vs %.1f us)\n",
+	       index_us < scan_us ? "yes" : "no", index_us, scan_us);
+	for (i = 1; i < count; i++)
+		sorted &= range[i - 1].timestamp <= range[i].timestamp;
+	printf("Sorted: %u, first: %lu, last: %lu\n", sorted,
+	       (unsigned long)range[0].timestamp,
+	       (unsigned long)range[count - 1].timestamp);
+
+	blockchain_range_by_time(blockchain, 0, START, &count);
+	printf("Before START: [%u]\n", count);
+	printf("Empty range: %p\n", (void *)blockchain_range_by_time(blockchain,
+	       START + NB_BLOCKS, UINT64_MAX, &count));
+
+	/* A reorganization replaces the entries of the detached Blocks */
+	block = block_create(llist_get_node_at(blockchain->chain, NB_BLOCKS - 1),
+			     (int8_t *)"Fork", 4);
+	block->info.difficulty = 8;
+	block->info.timestamp = START;
+	block_mine(block);
+	printf("Reorg: %d\n", blockchain_tree_add(blockchain, block));
+	blockchain_range_by_time(blockchain, 0, UINT64_MAX, &count);
+	printf("Indexed: [%u] of [%d]\n", count, llist_size(blockchain->chain));
+	blockchain_range_by_time(blockchain, START + NB_BLOCKS - 10, UINT64_MAX,
+				 &count);
+	printf("Last 10 seconds: [%u]\n", count);
+
+	/* The latest possible time is indexed, and detached, like any other */
+	tip = llist_get_tail(blockchain->chain);
+	block = block_create(tip, (int8_t *)"End", 3);
+	block->info.timestamp = UINT64_MAX;
+	block_hash(block, block->hash);
+	blockchain_add_block(blockchain, block);
+	blockchain_range_by_time(blockchain, UINT64_MAX, UINT64_MAX, &count);
+	printf("At the end of time: [%u]\n", count);
+	block = block_create(tip, (int8_t *)"Fork", 4);
+	block->info.difficulty = 8;
+	block->info.timestamp = START + NB_BLOCKS;
+	block_mine(block);
+	printf("Reorg: %d\n", blockchain_tree_add(blockchain, block));
+	blockchain_range_by_time(blockchain, UINT64_MAX, UINT64_MAX, &count);
+	printf("At the end of time: [%u], ", count);
+	blockchain_range_by_time(blockchain, 0, UINT64_MAX, &count);
+	printf("indexed: [%u] of [%d]\n", count, llist_size(blockchain->chain));
+
+	/* The index is built on load */
+	blockchain_serialize(blockchain, "time.hblk");
+	loaded = blockchain_deserialize("time.hblk");
+	blockchain_range_by_time(loaded, START + 1000, START + 1999, &count);
+	printf("Loaded range: [%u]\n", count);
+	blockchain_destroy(loaded);
+	remove("time.hblk");
+
+	blockchain_destroy(blockchain);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	100000
+
+/**
+ * struct sender_s - Arguments of the sender thread
+ *
+ * @blockchain: Blockchain to send
+ * @fd:         Write end of the pipe
+ * @flags:      Serialization flags
+ * @status:     Result of the serialization
+ */
+typedef struct sender_s
+{
+	blockchain_t const *blockchain;
+	int fd;
+	unsigned int flags;
+	int status;
+} sender_t;
+
+/**
+ * _send - Serializes a Blockchain to a pipe, then closes it
+ *
+ * @arg: Pointer to the sender arguments
+ *
+ * Return: NULL
+ */
+static void *_send(void *arg)
+{
+	sender_t *sender = (sender_t *)arg;
+
+	sender->status = blockchain_serialize_fd(sender->blockchain, sender->fd,
+						 sender->flags);
+	close(sender->fd);
+
+	return (NULL);
+}
+
+/**
+ * _replicate - Replicates a Blockchain through a pipe
+ *
+ * @blockchain: Blockchain to replicate
+ * @flags:      Serialization flags
+ */
+static void _replicate(blockchain_t const *blockchain, unsigned int flags)
+{
+	sender_t sender = {NULL, -1, 0, -1};
+	blockchain_t *replica;
+	pthread_t thread;
+	block_t *a, *b;
+	int fds[2];
+
+	pipe(fds);
+	sender.blockchain = blockchain;
+	sender.fd = fds[1];
+	sender.flags = flags;
+	pthread_create(&thread, NULL, _send, &sender);
+
+	replica = blockchain_deserialize_fd(fds[0], 0);
+	pthread_join(thread, NULL);
+	close(fds[0]);
+
+	a = llist_get_tail(blockchain->chain);
+	b = replica ? llist_get_tail(replica->chain) : NULL;
+	printf("Sent: %d, received [%d], tip %s\n", sender.status,
+	       replica ? llist_size(replica->chain) : -1,
+	       b && !memcmp(a, b, sizeof(*a)) ? "matches" : "differs");
+	blockchain_destroy(replica);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block;
+	int i, fds[2];
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton", 9);
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+
+	_replicate(blockchain, 0);
+	_replicate(blockchain, HBLK_CRC32C);
+	_replicate(blockchain, HBLK_ZLIB | HBLK_CRC32C);
+
+	/* A stream closed after the header is rejected */
+	pipe(fds);
+	write(fds[1], "HBLK1.0\x01\x05\x00\x00\x00", 12);
+	close(fds[1]);
+	printf("Truncated: %p\n", (void *)blockchain_deserialize_fd(fds[0], 0));
+	close(fds[0]);
+
+	blockchain_destroy(blockchain);
+	return (EXIT_SUCCESS);
+}
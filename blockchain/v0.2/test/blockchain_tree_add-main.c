@@ -0,0 +1,115 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "blockchain.h"
+
+void _blockchain_print_brief(blockchain_t const *blockchain);
+
+/**
+ * _mine - Creates and mines a Block on top of another one
+ *
+ * @prev:       Pointer to the parent Block
+ * @s:          Block data
+ * @difficulty: Block difficulty
+ *
+ * Return: Pointer to the mined Block
+ */
+static block_t *_mine(block_t const *prev, char const *s, uint32_t difficulty)
+{
+	block_t *block;
+
+	block = block_create(prev, (int8_t *)s, (uint32_t)strlen(s));
+	block->info.difficulty = difficulty;
+	block_mine(block);
+
+	return (block);
+}
+
+/**
+ * _reorg_bench - Times a reorganization of a given depth
+ *
+ * A chain of @depth Blocks at difficulty 0 is built, then a competing
+ * branch forking from the Genesis Block, with more work, is added
+ *
+ * @depth: Number of Blocks of the active chain to be replaced
+ */
+static void _reorg_bench(unsigned int depth)
+{
+	blockchain_t *blockchain;
+	block_t *block;
+	struct timespec start, end;
+	unsigned int i;
+	int ret = 0;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < depth; i++)
+	{
+		block = _mine(block, "main", 0);
+		blockchain_add_block(blockchain, block);
+	}
+
+	/* The branch only gets more work than the active chain with its tip */
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < depth / 2; i++)
+	{
+		block = _mine(block, "fork", 1);
+		blockchain_tree_add(blockchain, block);
+	}
+	block = _mine(block, "fork", 1);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	ret = blockchain_tree_add(blockchain, block);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	printf("Reorg of depth %u: tip %d, chain [%d], %.3f ms\n", depth, ret,
+	       llist_size(blockchain->chain),
+	       (end.tv_sec - start.tv_sec) * 1e3 +
+	       (end.tv_nsec - start.tv_nsec) / 1e6);
+
+	blockchain_destroy(blockchain);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block, *fork, *side;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	block = _mine(block, "Holberton", 0);
+	blockchain_add_block(blockchain, block);
+	fork = _mine(block, "School", 0);
+	blockchain_add_block(blockchain, fork);
+	block = _mine(fork, "of", 0);
+	blockchain_add_block(blockchain, block);
+
+	/* Same height as the tip, same work: kept on a side branch */
+	side = _mine(fork, "Software", 0);
+	printf("Competing Block: %d\n", blockchain_tree_add(blockchain, side));
+	printf("Duplicate Block: %d\n", blockchain_tree_add(blockchain, side));
+
+	/* More work on the side branch: the active chain switches to it */
+	side = _mine(side, "Engineering", 1);
+	printf("Heavier Block: %d\n", blockchain_tree_add(blockchain, side));
+	_blockchain_print_brief(blockchain);
+
+	/* Back on the former tip, which is now on a side branch */
+	block = _mine(block, "972", 2);
+	printf("Heavier Block: %d\n", blockchain_tree_add(blockchain, block));
+	printf("Tip: %u\n", blockchain_tip(blockchain)->block->info.index);
+	blockchain_destroy(blockchain);
+
+	_reorg_bench(4);
+	_reorg_bench(256);
+	_reorg_bench(4096);
+
+	return (EXIT_SUCCESS);
+}
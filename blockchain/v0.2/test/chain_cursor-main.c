@@ -0,0 +1,116 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	1000000
+
+/**
+ * _sum_block - Callback summing the nonce and data length of a Block
+ *
+ * @node: Pointer to the Block
+ * @idx:  Index of the Block (unused)
+ * @arg:  Pointer to the sum
+ *
+ * Return: 0
+ */
+static int _sum_block(llist_node_t node, unsigned int idx, void *arg)
+{
+	block_t const *block = (block_t const *)node;
+
+	(void)idx;
+	*(uint64_t *)arg += block->info.nonce + block->data.len;
+	return (0);
+}
+
+/**
+ * _elapsed - Computes the time elapsed since a given time
+ *
+ * @start: Start time
+ *
+ * Return: Elapsed time, in milliseconds
+ */
+static double _elapsed(struct timespec const *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return ((end.tv_sec - start->tv_sec) * 1e3 +
+		(end.tv_nsec - start->tv_nsec) / 1e6);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block;
+	block_t const *batch[CHAIN_CURSOR_BATCH];
+	chain_cursor_t cursor;
+	struct timespec start;
+	uint64_t sum_cb = 0, sum_next = 0, sum_batch = 0;
+	uint32_t count, i;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton", 1 + i % 9);
+		block->info.nonce = i;
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	llist_for_each(blockchain->chain, _sum_block, &sum_cb);
+	printf("llist_for_each: %lu in %.3f ms\n", sum_cb, _elapsed(&start));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	chain_cursor_open(&cursor, blockchain);
+	while ((block = (block_t *)chain_cursor_next(&cursor)) != NULL)
+		sum_next += block->info.nonce + block->data.len;
+	chain_cursor_close(&cursor);
+	printf("chain_cursor_next: %lu in %.3f ms\n", sum_next,
+	       _elapsed(&start));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	chain_cursor_open(&cursor, blockchain);
+	while ((count = chain_cursor_batch(&cursor, batch,
+					   CHAIN_CURSOR_BATCH)) != 0)
+	{
+		for (i = 0; i < count; i++)
+			sum_batch += batch[i]->info.nonce + batch[i]->data.len;
+	}
+	chain_cursor_close(&cursor);
+	printf("chain_cursor_batch: %lu in %.3f ms\n", sum_batch,
+	       _elapsed(&start));
+
+	/* With a chain view, the cursor doesn't have to gather the Blocks */
+	blockchain_view_enable(blockchain);
+	sum_batch = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	chain_cursor_open(&cursor, blockchain);
+	while ((count = chain_cursor_batch(&cursor, batch,
+					   CHAIN_CURSOR_BATCH)) != 0)
+	{
+		for (i = 0; i < count; i++)
+			sum_batch += batch[i]->info.nonce + batch[i]->data.len;
+	}
+	chain_cursor_close(&cursor);
+	printf("chain_cursor_batch (view): %lu in %.3f ms\n", sum_batch,
+	       _elapsed(&start));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	blockchain_serialize(blockchain, "cursor.hblk");
+	printf("blockchain_serialize: %.3f ms\n", _elapsed(&start));
+
+	blockchain_destroy(blockchain);
+
+	return (sum_cb == sum_next && sum_cb == sum_batch ?
+		EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,141 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "blockchain.h"
+
+#define NB_READERS	4
+#define NB_BLOCKS	100000
+
+/**
+ * struct reader_s - Reader thread statistics
+ *
+ * @blockchain: Pointer to the Blockchain to read
+ * @snapshots:  Number of snapshots taken
+ * @blocks:     Number of Blocks read
+ * @errors:     Number of inconsistent Blocks seen
+ */
+typedef struct reader_s
+{
+	blockchain_t *blockchain;
+	unsigned long snapshots;
+	unsigned long blocks;
+	unsigned long errors;
+} reader_t;
+
+static atomic_int done;
+
+/**
+ * _reader - Reader thread: iterates snapshots until the writer is done
+ *
+ * @arg: Pointer to the reader statistics
+ *
+ * Return: NULL
+ */
+static void *_reader(void *arg)
+{
+	reader_t *r = (reader_t *)arg;
+	chain_view_t *view = r->blockchain->view;
+	chain_snapshot_t snap;
+	uint32_t i;
+	int id = chain_view_reader(view);
+
+	while (!atomic_load(&done))
+	{
+		chain_view_snapshot(view, id, &snap);
+		for (i = 1; i < snap.size; i++)
+		{
+			if (snap.blocks[i]->info.index != i ||
+			    memcmp(snap.blocks[i]->info.prev_hash,
+				   snap.blocks[i - 1]->hash, SHA256_DIGEST_LENGTH))
+				r->errors++;
+		}
+		chain_view_release(view, id);
+		r->snapshots++;
+		r->blocks += snap.size;
+	}
+
+	return (NULL);
+}
+
+/**
+ * _writer - Appends Blocks, then reorganizes the chain
+ *
+ * @blockchain: Pointer to the Blockchain to append Blocks to
+ *
+ * Return: Pointer to the tip of the heavier branch
+ */
+static block_t *_writer(blockchain_t *blockchain)
+{
+	block_t *block, *fork;
+	int i;
+
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton", 9);
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+		if (i == NB_BLOCKS - 10)
+			fork = block;
+	}
+
+	/* Replace the last 10 Blocks with a heavier branch */
+	for (i = 0; i < 6; i++)
+	{
+		fork = block_create(fork, (int8_t *)"School", 6);
+		fork->info.difficulty = 1;
+		block_mine(fork);
+		blockchain_tree_add(blockchain, fork);
+	}
+
+	return (fork);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *tip;
+	pthread_t threads[NB_READERS];
+	reader_t readers[NB_READERS];
+	struct timespec start, end;
+	double elapsed;
+	int i;
+
+	blockchain = blockchain_create();
+	blockchain_view_enable(blockchain);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < NB_READERS; i++)
+	{
+		memset(&readers[i], 0, sizeof(readers[i]));
+		readers[i].blockchain = blockchain;
+		pthread_create(&threads[i], NULL, _reader, &readers[i]);
+	}
+	tip = _writer(blockchain);
+	atomic_store(&done, 1);
+	for (i = 0; i < NB_READERS; i++)
+		pthread_join(threads[i], NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	elapsed = (end.tv_sec - start.tv_sec) +
+		(end.tv_nsec - start.tv_nsec) / 1e9;
+
+	printf("Chain [%d], reorganized: %s, %.3f s\n",
+	       llist_size(blockchain->chain),
+	       llist_get_tail(blockchain->chain) == tip ? "yes" : "no", elapsed);
+	for (i = 0; i < NB_READERS; i++)
+		printf("Reader %d: %lu snapshots, %.1f Mblocks/s, %lu errors\n",
+		       i, readers[i].snapshots,
+		       readers[i].blocks / elapsed / 1e6, readers[i].errors);
+
+	blockchain_destroy(blockchain);
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,138 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	200000
+#define START		1700000000
+
+/**
+ * _elapsed - Computes the time elapsed since a given time
+ *
+ * @start: Start time
+ *
+ * Return: the elapsed time, in milliseconds
+ */
+static double _elapsed(struct timespec const *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return ((end.tv_sec - start->tv_sec) * 1e3 +
+		(end.tv_nsec - start->tv_nsec) / 1e6);
+}
+
+/**
+ * _check - Compares the columns of an export with the Blocks of a chain
+ *
+ * @columns:    Mapped columns
+ * @blockchain: Exported Blockchain
+ *
+ * Return: 1 if every column matches, 0 otherwise
+ */
+static int _check(hblk_columns_t const *columns,
+		  blockchain_t const *blockchain)
+{
+	chain_cursor_t cursor;
+	block_t const *block;
+	uint32_t i = 0;
+	int same = 1;
+
+	chain_cursor_open(&cursor, blockchain);
+	while (same && (block = chain_cursor_next(&cursor)) != NULL)
+	{
+		same = columns->index[i] == block->info.index &&
+			columns->difficulty[i] == block->info.difficulty &&
+			columns->timestamp[i] == block->info.timestamp &&
+			columns->nonce[i] == block->info.nonce &&
+			!memcmp(columns->prev_hash[i], block->info.prev_hash,
+				SHA256_DIGEST_LENGTH) &&
+			!memcmp(columns->hash[i], block->hash,
+				SHA256_DIGEST_LENGTH) &&
+			columns->data_len[i] == block->data.len;
+		i++;
+	}
+	chain_cursor_close(&cursor);
+
+	return (same && i == columns->count);
+}
+
+/**
+ * _scan_rows - Computes the mean difficulty by scanning the Blocks
+ *
+ * @blockchain: Blockchain to scan
+ *
+ * Return: the mean difficulty
+ */
+static double _scan_rows(blockchain_t const *blockchain)
+{
+	chain_cursor_t cursor;
+	block_t const *block;
+	uint64_t sum = 0;
+
+	chain_cursor_open(&cursor, blockchain);
+	while ((block = chain_cursor_next(&cursor)) != NULL)
+		sum += block->info.difficulty;
+	chain_cursor_close(&cursor);
+
+	return ((double)sum / llist_size(blockchain->chain));
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	hblk_columns_t columns;
+	hblk_series_t series;
+	struct timespec start;
+	block_t *block;
+	double mean, rows_ms, cols_ms;
+	uint32_t i;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton", 9);
+		block->info.difficulty = 8 + i / 25000;
+		block->info.timestamp = START + i * 2 + (i * 2654435761U >> 30);
+		block->info.nonce = i * 31;
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+
+	printf("Export: %d\n", blockchain_export_columns(blockchain,
+							 "columns.hblc"));
+	if (hblk_columns_map(&columns, "columns.hblc") != 0)
+	{
+		fprintf(stderr, "hblk_columns_map() failed\n");
+		return (EXIT_FAILURE);
+	}
+	printf("Columns: [%u] Blocks, %lu bytes, match: %d\n", columns.count,
+	       (unsigned long)columns.size, _check(&columns, blockchain));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	mean = _scan_rows(blockchain);
+	rows_ms = _elapsed(&start);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	hblk_difficulty_series(&columns, columns.count, &series);
+	cols_ms = _elapsed(&start);
+	printf("Mean difficulty: %.4f (rows) %.4f (columns)\n", mean,
+	       series.mean);
+	printf("Columns faster than rows: %s (%.2f ms vs %.2f ms)\n",
+	       cols_ms < rows_ms ? "yes" : "no", cols_ms, rows_ms);
+	hblk_columns_unmap(&columns);
+
+	hblk_columns_report("columns.hblc", 6, 1, 25000);
+	printf("Invalid: %d\n", hblk_columns_map(&columns, "nope.hblc"));
+
+	remove("columns.hblc");
+	blockchain_destroy(blockchain);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	2000
+
+/**
+ * _append - Appends Blocks to a Blockchain, journaling them
+ *
+ * @blockchain:  Pointer to the Blockchain
+ * @path:        Path to the journal
+ * @max_pending: Number of pending records triggering an fsync
+ * @max_delay:   Latency budget, in milliseconds
+ */
+static void _append(blockchain_t *blockchain, char const *path,
+		    uint32_t max_pending, uint32_t max_delay)
+{
+	hblk_journal_t *journal;
+	struct timespec start, end;
+	block_t *block = llist_get_tail(blockchain->chain);
+	double elapsed;
+	uint64_t syncs;
+	int i;
+
+	journal = hblk_journal_open(path, max_pending, max_delay);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton", 9);
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+		hblk_journal_append(journal, block);
+	}
+	syncs = journal->syncs;
+	hblk_journal_close(journal);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	elapsed = (end.tv_sec - start.tv_sec) +
+		(end.tv_nsec - start.tv_nsec) / 1e9;
+	printf("max_pending %u, max_delay %u ms: %lu fsyncs, %.0f blocks/s\n",
+	       max_pending, max_delay, syncs, NB_BLOCKS / elapsed);
+}
+
+/**
+ * _recover - Loads the snapshot and replays the journal onto it
+ *
+ * @blockchain: Pointer to the Blockchain that was journaled
+ *
+ * Return: Pointer to the recovered Blockchain
+ */
+static blockchain_t *_recover(blockchain_t const *blockchain)
+{
+	blockchain_t *recovered;
+	off_t end;
+	int replayed;
+
+	recovered = blockchain_deserialize("snapshot.hblk");
+	printf("Snapshot: [%d]\n", llist_size(recovered->chain));
+	replayed = hblk_journal_replay(recovered, "journal.hblj", &end);
+	printf("Replayed: %d, valid up to %ld\n", replayed, (long)end);
+	printf("Recovered: [%d] of [%d]\n", llist_size(recovered->chain),
+	       llist_size(blockchain->chain));
+
+	return (recovered);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain, *recovered;
+	hblk_journal_t *journal;
+	FILE *file;
+	long size;
+
+	remove("journal.hblj");
+	blockchain = blockchain_create();
+	blockchain_serialize_flags(blockchain, "snapshot.hblk",
+				   HBLK_CRC32C | HBLK_DURABLE);
+
+	_append(blockchain, "journal.hblj", 0, 0);
+	_append(blockchain, "journal.hblj", 1, 0);
+	_append(blockchain, "journal.hblj", 64, 0);
+	_append(blockchain, "journal.hblj", 0, 2);
+
+	/* Simulate a crash in the middle of the last record */
+	file = fopen("journal.hblj", "r+b");
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fclose(file);
+	truncate("journal.hblj", size - 10);
+
+	recovered = _recover(blockchain);
+
+	/* Replaying again is a no-op */
+	printf("Replayed: %d\n",
+	       hblk_journal_replay(recovered, "journal.hblj", NULL));
+
+	/* Append after the torn record: reopening cuts it off */
+	blockchain_destroy(blockchain);
+	blockchain = recovered;
+	_append(blockchain, "journal.hblj", 64, 0);
+	recovered = _recover(blockchain);
+	blockchain_destroy(recovered);
+
+	/* Once the blockchain is durably saved, the journal can be emptied */
+	blockchain_serialize_flags(blockchain, "snapshot.hblk",
+				   HBLK_CRC32C | HBLK_DURABLE);
+	journal = hblk_journal_open("journal.hblj", 0, 0);
+	printf("Reset: %d\n", hblk_journal_reset(journal));
+	hblk_journal_close(journal);
+	recovered = _recover(blockchain);
+
+	blockchain_destroy(recovered);
+	blockchain_destroy(blockchain);
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,49 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	1000
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	block_t *block, *prev;
+	hblk_hist_t hist;
+	uint32_t i;
+	int valid = 0;
+
+	blockchain = blockchain_create();
+	prev = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(prev, (int8_t *)"Holberton", 9);
+		block_hash(block, block->hash);
+		valid += block_is_valid(block, prev) == 0;
+		blockchain_add_block(blockchain, block);
+		prev = block;
+	}
+	printf("Valid: %d\n", valid);
+
+	hblk_latency_get(HBLK_LAT_BLOCK_VALID, &hist);
+	printf("%s: %lu\n", hblk_latency_name(HBLK_LAT_BLOCK_VALID),
+	       (unsigned long)hist.count);
+	hblk_latency_get(HBLK_LAT_BLOCK_APPEND, &hist);
+	printf("%s: %lu, p50 <= p99: %d\n",
+	       hblk_latency_name(HBLK_LAT_BLOCK_APPEND),
+	       (unsigned long)hist.count, hblk_hist_percentile(&hist, 50) <=
+	       hblk_hist_percentile(&hist, 99));
+
+	hblk_latency_reset();
+	block_is_valid(prev, llist_get_node_at(blockchain->chain,
+					       NB_BLOCKS - 1));
+	hblk_latency_print(stdout);
+
+	blockchain_destroy(blockchain);
+	return (EXIT_SUCCESS);
+}
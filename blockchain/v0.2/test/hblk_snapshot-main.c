@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	200000
+#define NB_APPENDED	20000
+
+static atomic_int done;
+
+/**
+ * _progress - Reports the progress of the snapshot
+ *
+ * @written: Number of Blocks written so far
+ * @total:   Number of Blocks to write
+ * @arg:     Number of reports so far
+ */
+static void _progress(uint32_t written, uint32_t total, void *arg)
+{
+	int *reports = (int *)arg;
+
+	if (++*reports == 1 || written == total)
+		printf("Snapshot: [%u/%u]\n", written, total);
+}
+
+/**
+ * _done - Reports the completion of the snapshot
+ *
+ * @status: 0 on success, -1 on failure
+ * @arg:    Number of progress reports
+ */
+static void _done(int status, void *arg)
+{
+	printf("Snapshot done: %d, %d progress reports\n", status, *(int *)arg);
+	atomic_store(&done, 1);
+}
+
+/**
+ * _append - Appends Blocks to a Blockchain
+ *
+ * @blockchain: Pointer to the Blockchain
+ * @n:          Number of Blocks to append
+ */
+static void _append(blockchain_t *blockchain, int n)
+{
+	block_t *block = llist_get_tail(blockchain->chain);
+	int i;
+
+	for (i = 0; i < n; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton", 9);
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain, *loaded;
+	hblk_snapshot_t *snapshot;
+	int reports = 0, appended = 0;
+
+	blockchain = blockchain_create();
+	blockchain_view_enable(blockchain);
+	_append(blockchain, NB_BLOCKS);
+
+	snapshot = blockchain_snapshot_async(blockchain, "snapshot.hblk",
+					     HBLK_CRC32C, _progress, _done,
+					     &reports);
+	/* The chain keeps growing while the snapshot is written */
+	while (appended < NB_APPENDED && !atomic_load(&done))
+	{
+		_append(blockchain, 100);
+		appended += 100;
+	}
+	if (hblk_snapshot_wait(snapshot) != 0)
+		return (EXIT_FAILURE);
+
+	loaded = blockchain_deserialize("snapshot.hblk");
+	printf("Snapshot has [%d] Blocks, the chain grew while writing: %s\n",
+	       loaded ? llist_size(loaded->chain) : -1,
+	       llist_size(blockchain->chain) > NB_BLOCKS + 1 ? "yes" : "no");
+
+	blockchain_destroy(loaded);
+	blockchain_destroy(blockchain);
+	remove("snapshot.hblk");
+
+	return (EXIT_SUCCESS);
+}
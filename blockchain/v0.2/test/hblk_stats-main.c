@@ -0,0 +1,50 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	1000
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	struct stat st;
+	block_t *block;
+	uint32_t i;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton", 9);
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+	/* Invalid arguments allocate nothing, and aren't counted */
+	block_create(NULL, (int8_t *)"Holberton", 9);
+	printf("block_alloc: %lu\n",
+	       (unsigned long)hblk_stat_get(HBLK_STAT_BLOCK_ALLOC));
+	printf("block_hash: %lu, bytes: %lu\n",
+	       (unsigned long)hblk_stat_get(HBLK_STAT_BLOCK_HASH),
+	       (unsigned long)hblk_stat_get(HBLK_STAT_BLOCK_HASH_BYTES));
+
+	hblk_stats_reset();
+	blockchain_serialize_flags(blockchain, "stats.hblk", HBLK_CRC32C);
+	stat("stats.hblk", &st);
+	printf("write_blocks: %lu, bytes: %lu (file: %ld)\n",
+	       (unsigned long)hblk_stat_get(HBLK_STAT_WRITE_BLOCKS),
+	       (unsigned long)hblk_stat_get(HBLK_STAT_WRITE_BYTES),
+	       (long)st.st_size);
+	remove("stats.hblk");
+	hblk_stats_print(stdout);
+
+	blockchain_destroy(blockchain);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,101 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	1000
+#define SEG_HEIGHT	128
+
+/**
+ * _forge - Forges the Block count of a segment, with a valid CRC32C
+ *
+ * @path: Path to the segment file
+ *
+ * Return: the value returned by hblk_segment_map() on the forged segment
+ */
+static int _forge(char const *path)
+{
+	hblk_segment_t segment;
+	uint8_t header[16];
+	uint32_t count = UINT32_MAX, crc;
+	FILE *file = fopen(path, "r+b");
+	int ret;
+
+	if (!file || fread(header, sizeof(header), 1, file) != 1)
+		return (-2);
+	memcpy(header + 8, &count, sizeof(count));
+	crc = crc32c(0, header, 12);
+	memcpy(header + 12, &crc, sizeof(crc));
+	fseek(file, 0, SEEK_SET);
+	fwrite(header, sizeof(header), 1, file);
+	fclose(file);
+
+	memset(&segment, 0, sizeof(segment));
+	ret = hblk_segment_map(&segment, path);
+	hblk_segment_unmap(&segment);
+
+	return (ret);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	blockchain_t *blockchain;
+	hblk_store_t *store;
+	block_t *block, copy;
+	chain_cursor_t cursor;
+	block_t const *b;
+	int i;
+
+	system("rm -rf store.d");
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(block, (int8_t *)"Holberton", 1 + i % 9);
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+
+	store = hblk_store_open("store.d", SEG_HEIGHT);
+	chain_cursor_open(&cursor, blockchain);
+	while ((b = chain_cursor_next(&cursor)) != NULL)
+		hblk_store_append(store, b);
+	chain_cursor_close(&cursor);
+	printf("Stored [%u] in %u sealed segments + %u\n",
+	       hblk_store_size(store), store->nsealed, store->nactive);
+	hblk_store_close(store);
+
+	/* Reopening only reads the manifest and the active segment */
+	store = hblk_store_open("store.d", 1);
+	printf("Reopened [%u]: height %u, %u sealed segments + %u\n",
+	       hblk_store_size(store), store->seg_height, store->nsealed,
+	       store->nactive);
+
+	chain_cursor_open(&cursor, blockchain);
+	for (i = 0; (b = chain_cursor_next(&cursor)) != NULL; i++)
+	{
+		if (hblk_store_get(store, i, &copy) != 0 ||
+		    memcmp(&copy, b, sizeof(copy)))
+		{
+			fprintf(stderr, "Block %d differs\n", i);
+			return (EXIT_FAILURE);
+		}
+	}
+	chain_cursor_close(&cursor);
+	printf("All Blocks match, get(%d): %d\n", i,
+	       hblk_store_get(store, i, &copy));
+
+	hblk_store_close(store);
+	blockchain_destroy(blockchain);
+	printf("Forged segment: %d\n", _forge("store.d/seg-000000.hblk"));
+	fflush(stdout);
+	system("ls store.d | wc -l; rm -rf store.d");
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "blockchain.h"
+#include "hblk_crypto.h"
+
+#define NB_THREADS	3
+#define NB_BLOCKS	50
+
+/**
+ * _mine - Mines, validates and hashes a chain of blocks from a thread
+ *
+ * @arg: Unused
+ *
+ * Return: NULL
+ */
+static void *_mine(void *arg)
+{
+	blockchain_t *blockchain = blockchain_create();
+	block_t *block, *prev;
+	int i;
+
+	(void)arg;
+	prev = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		block = block_create(prev, (int8_t *)"Holberton", 9);
+		block->info.difficulty = 4;
+		block_mine(block);
+		block_is_valid(block, prev);
+		blockchain_add_block(blockchain, block);
+		prev = block;
+	}
+	blockchain_destroy(blockchain);
+
+	return (NULL);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	pthread_t threads[NB_THREADS];
+	blockchain_t *blockchain, *loaded;
+	EC_KEY *key = ec_create();
+	uint8_t digest[SHA256_DIGEST_LENGTH] = {0};
+	sig_t sig;
+	int i;
+
+	/* Nothing is recorded before tracing starts */
+	_mine(NULL);
+	printf("Stopped: %d\n", hblk_trace_stop(NULL));
+	printf("Bad capacity: %d\n", hblk_trace_start(1000));
+
+	hblk_trace_start(0);
+	for (i = 0; i < NB_THREADS; i++)
+		pthread_create(&threads[i], NULL, _mine, NULL);
+	for (i = 0; i < NB_THREADS; i++)
+		pthread_join(threads[i], NULL);
+	ec_sign(key, digest, SHA256_DIGEST_LENGTH, &sig);
+	ec_verify(key, digest, SHA256_DIGEST_LENGTH, &sig);
+	blockchain = blockchain_create();
+	blockchain_serialize(blockchain, "trace.hblk");
+	loaded = blockchain_deserialize("trace.hblk");
+	remove("trace.hblk");
+	printf("Spans: %d\n", hblk_trace_stop("trace.json"));
+
+	/* A ring smaller than the spans recorded keeps the latest ones */
+	hblk_trace_start(16);
+	pthread_create(&threads[0], NULL, _mine, NULL);
+	pthread_join(threads[0], NULL);
+	printf("Wrapped: %d\n", hblk_trace_stop("wrapped.json"));
+	remove("wrapped.json");
+
+	blockchain_destroy(loaded);
+	blockchain_destroy(blockchain);
+	EC_KEY_free(key);
+	return (EXIT_SUCCESS);
+}
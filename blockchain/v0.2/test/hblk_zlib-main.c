@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	100000
+
+/**
+ * _elapsed - Computes the time elapsed since a given time
+ *
+ * @start: Start time
+ *
+ * Return: the elapsed time, in seconds
+ */
+static double _elapsed(struct timespec const *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return ((end.tv_sec - start->tv_sec) +
+		(end.tv_nsec - start->tv_nsec) / 1e9);
+}
+
+/**
+ * _bench - Saves and loads a Blockchain in a given format, and prints the
+ * file size and throughputs
+ *
+ * @blockchain: Blockchain to save
+ * @path:       Path to the file to save it to
+ * @flags:      Serialization flags
+ * @raw:        Size of the uncompressed file, throughputs are based on it
+ *
+ * Return: the size of the file
+ */
+static double _bench(blockchain_t const *blockchain, char const *path,
+		     unsigned int flags, double raw)
+{
+	struct timespec start;
+	blockchain_t *loaded;
+	double write_s, load_s;
+	struct stat st;
+	block_t *a, *b;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	blockchain_serialize_flags(blockchain, path, flags);
+	write_s = _elapsed(&start);
+	stat(path, &st);
+	if (!raw)
+		raw = st.st_size;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	loaded = blockchain_deserialize(path);
+	load_s = _elapsed(&start);
+
+	a = llist_get_node_at(blockchain->chain, NB_BLOCKS / 2);
+	b = loaded ? llist_get_node_at(loaded->chain, NB_BLOCKS / 2) : NULL;
+	printf("%-10s %10ld bytes (%5.1f%%), ", path, (long)st.st_size,
+	       100. * st.st_size / raw);
+	printf("write %7.1f MB/s, load %7.1f MB/s%s\n",
+	       raw / write_s / 1e6, raw / load_s / 1e6,
+	       b && llist_size(loaded->chain) == NB_BLOCKS + 1 &&
+	       !memcmp(a, b, sizeof(*a)) ? "" : " MISMATCH");
+	blockchain_destroy(loaded);
+	remove(path);
+
+	return (raw);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	int8_t data[BLOCKCHAIN_DATA_MAX];
+	blockchain_t *blockchain;
+	block_t *block;
+	double raw;
+	int i, len;
+
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		/* Text payloads, from a few bytes up to BLOCKCHAIN_DATA_MAX */
+		for (len = 0; len < BLOCKCHAIN_DATA_MAX - 64 && len < i % 1024;)
+			len += sprintf((char *)data + len, "{\"from\":\"%s\","
+				       "\"to\":\"%s\",\"amount\":%d},",
+				       "holberton", "school",
+				       (i * 7919 + len) % 100000);
+		block = block_create(block, data, len ? len : 8);
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+
+	raw = _bench(blockchain, "plain.hblk", 0, 0);
+	_bench(blockchain, "crc.hblk", HBLK_CRC32C, raw);
+	_bench(blockchain, "zlib.hblk", HBLK_ZLIB, raw);
+	_bench(blockchain, "zcrc.hblk", HBLK_ZLIB | HBLK_CRC32C, raw);
+	blockchain_destroy(blockchain);
+
+	return (EXIT_SUCCESS);
+}
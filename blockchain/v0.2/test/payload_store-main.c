@@ -0,0 +1,141 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "blockchain.h"
+
+#define NB_BLOCKS	100000
+#define NB_PAYLOADS	64
+
+/**
+ * _same - Compares the active chains of two Blockchains
+ *
+ * @a: First Blockchain
+ * @b: Second Blockchain
+ *
+ * Return: 1 if they hold the same Blocks, 0 otherwise
+ */
+static int _same(blockchain_t const *a, blockchain_t const *b)
+{
+	chain_cursor_t ca, cb;
+	block_t const *x, *y;
+	int same;
+
+	if (!b || llist_size(a->chain) != llist_size(b->chain))
+		return (0);
+	chain_cursor_open(&ca, a);
+	chain_cursor_open(&cb, b);
+	do {
+		x = chain_cursor_next(&ca);
+		y = chain_cursor_next(&cb);
+		same = (!x && !y) || (x && y && !memcmp(x, y, sizeof(*x)));
+	} while (same && x);
+	chain_cursor_close(&ca);
+	chain_cursor_close(&cb);
+
+	return (same);
+}
+
+/**
+ * _save - Saves a Blockchain, loads it back, and prints the file size
+ *
+ * @blockchain: Blockchain to save
+ * @path:       Path to the file
+ * @flags:      Serialization flags
+ */
+static void _save(blockchain_t const *blockchain, char const *path,
+		  unsigned int flags)
+{
+	blockchain_t *loaded;
+	struct stat st;
+
+	blockchain_serialize_flags(blockchain, path, flags);
+	stat(path, &st);
+	loaded = blockchain_deserialize(path);
+	printf("%-11s %9ld bytes, %s\n", path, (long)st.st_size,
+	       _same(blockchain, loaded) ? "loaded back" : "MISMATCH");
+	blockchain_destroy(loaded);
+	remove(path);
+}
+
+/**
+ * _lie - Saves a Blockchain with a forged Block count, and loads it back
+ *
+ * @blockchain: Blockchain to save
+ * @path:       Path to the file
+ */
+static void _lie(blockchain_t const *blockchain, char const *path)
+{
+	uint32_t num_blocks = UINT32_MAX;
+	blockchain_t *loaded;
+	FILE *file;
+
+	blockchain_serialize_flags(blockchain, path, HBLK_DEDUP);
+	file = fopen(path, "r+b");
+	fseek(file, 8, SEEK_SET);
+	fwrite(&num_blocks, sizeof(num_blocks), 1, file);
+	fclose(file);
+	loaded = blockchain_deserialize(path);
+	printf("%-11s forged count, %s\n", path,
+	       loaded ? "LOADED" : "rejected");
+	blockchain_destroy(loaded);
+	remove(path);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	int8_t payloads[NB_PAYLOADS][BLOCKCHAIN_DATA_MAX], unique[32];
+	blockchain_t *blockchain;
+	payload_store_t *store;
+	payload_t *a, *b;
+	block_t *block;
+	int i, len;
+
+	for (i = 0; i < NB_PAYLOADS; i++)
+		memset(payloads[i], 'A' + i % 26, BLOCKCHAIN_DATA_MAX);
+	blockchain = blockchain_create();
+	block = llist_get_head(blockchain->chain);
+	for (i = 0; i < NB_BLOCKS; i++)
+	{
+		/* Most Blocks carry one of a few recurring payloads */
+		len = 32 + (i % NB_PAYLOADS) * 15;
+		block = block_create(block, payloads[i % NB_PAYLOADS], len);
+		if (i % 10 == 0)
+		{
+			len = snprintf((char *)unique, sizeof(unique),
+				       "Holberton School, Block #%d", i);
+			memcpy(block->data.buffer, unique, len);
+		}
+		block_hash(block, block->hash);
+		blockchain_add_block(blockchain, block);
+	}
+
+	store = blockchain_payloads(blockchain);
+	payload_store_print(store);
+	payload_store_destroy(store);
+
+	_save(blockchain, "plain.hblk", 0);
+	_save(blockchain, "dedup.hblk", HBLK_DEDUP);
+	_save(blockchain, "dzcrc.hblk", HBLK_DEDUP | HBLK_ZLIB | HBLK_CRC32C);
+	_lie(blockchain, "forged.hblk");
+	blockchain_destroy(blockchain);
+
+	/* References are counted, and released entries are removed */
+	store = payload_store_create();
+	a = payload_store_put(store, (int8_t *)"Holberton", 9, 0);
+	b = payload_store_put(store, (int8_t *)"Holberton", 9, 1);
+	printf("Same entry: %d, refs: %u, first: %u\n", a == b, a->refs,
+	       a->first);
+	payload_store_release(store, a);
+	payload_store_release(store, b);
+	payload_store_print(store);
+	payload_store_destroy(store);
+
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,164 @@
+#include "blockchain.h"
+
+/**
+ * time_index_bound - program that locates the first entry of a timestamp
+ * index at or after a given time
+ *
+ * @index: a pointer to the index
+ * @timestamp: the time to look for
+ *
+ * Return: the position of the first entry whose timestamp is greater than
+ *         or equal to @timestamp, or the number of entries if there is none
+ */
+
+uint32_t time_index_bound(time_index_t const *index, uint64_t timestamp)
+{
+	uint32_t lo = 0, hi = index->count, mid;
+
+	while (lo < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+		if (index->entries[mid].timestamp < timestamp)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return (lo);
+}
+
+
+
+/**
+ * time_index_init - program that initializes an empty timestamp index
+ *
+ * @index: a pointer to the index to initialize
+ *
+ * Return: 0 on success, -1 if the entries could not be allocated
+ */
+
+int time_index_init(time_index_t *index)
+{
+	if (!index)
+		return (-1);
+
+	index->entries = malloc(TIME_INDEX_MIN_ENTRIES *
+				sizeof(*index->entries));
+	if (!index->entries)
+		return (-1);
+
+	index->capacity = TIME_INDEX_MIN_ENTRIES;
+	index->count = 0;
+
+	return (0);
+}
+
+
+
+/**
+ * time_index_clear - program that frees the entries of a timestamp index
+ *
+ * @index: a pointer to the index to clear
+ *
+ * Return: nothing (void)
+ */
+
+void time_index_clear(time_index_t *index)
+{
+	if (!index)
+		return;
+
+	free(index->entries);
+	index->entries = NULL;
+	index->capacity = 0;
+	index->count = 0;
+}
+
+
+
+/**
+ * time_index_add - program that adds a block appended to the active chain
+ * to a timestamp index
+ *
+ * a block at least as recent as the last entry is appended; an older one
+ * is inserted after the entries of the same time, so blocks of the same
+ * time stay in chain order
+ *
+ * @index: a pointer to the index
+ * @block: a pointer to the block
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int time_index_add(time_index_t *index, block_t *block)
+{
+	time_entry_t *entries;
+	uint32_t pos;
+
+	if (!index || !block)
+		return (-1);
+
+	if (index->count == index->capacity)
+	{
+		entries = realloc(index->entries, index->capacity * 2 *
+				  sizeof(*entries));
+		if (!entries)
+			return (-1);
+		index->entries = entries;
+		index->capacity *= 2;
+	}
+
+	pos = index->count;
+	if (pos && index->entries[pos - 1].timestamp > block->info.timestamp)
+	{
+		pos = block->info.timestamp == UINT64_MAX ? index->count :
+			time_index_bound(index, block->info.timestamp + 1);
+		memmove(&index->entries[pos + 1], &index->entries[pos],
+			(index->count - pos) * sizeof(*index->entries));
+	}
+	index->entries[pos].timestamp = block->info.timestamp;
+	index->entries[pos].block = block;
+	index->count++;
+
+	return (0);
+}
+
+
+
+/**
+ * time_index_remove - program that removes a block detached from
+ * the active chain from a timestamp index
+ *
+ * the entry is found by a binary search on the timestamp of the block,
+ * then looked for backwards from the last entry of that time: detached
+ * blocks are the latest of the chain, so this is where they are found,
+ * even when many blocks share a timestamp
+ *
+ * @index: a pointer to the index
+ * @block: a pointer to the block
+ *
+ * Return: 0 on success, -1 if the block is not indexed
+ */
+
+int time_index_remove(time_index_t *index, block_t const *block)
+{
+	uint32_t pos;
+
+	if (!index || !block)
+		return (-1);
+
+	pos = block->info.timestamp == UINT64_MAX ? index->count :
+		time_index_bound(index, block->info.timestamp + 1);
+	while (pos > 0 && index->entries[pos - 1].block != block &&
+	       index->entries[pos - 1].timestamp == block->info.timestamp)
+		pos--;
+	if (pos == 0 || index->entries[pos - 1].block != block)
+		return (-1);
+
+	pos--;
+	index->count--;
+	memmove(&index->entries[pos], &index->entries[pos + 1],
+		(index->count - pos) * sizeof(*index->entries));
+
+	return (0);
+}
@@ -0,0 +1,289 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hblk_crypto.h"
+#include "hblk_bench.h"
+#include "hblk_key_cache.h"
+#include "hblk_verify_pool.h"
+#include "hblk_sig_cache.h"
+
+#define NB_SIGNERS	16
+#define NB_BATCH	256
+
+/**
+ * struct fixture_s - Inputs shared by the cases
+ *
+ * @key:    Key pair
+ * @pub:    Public key of @key
+ * @msg:    Message to hash, of the size of a block payload
+ * @digest: Digest of @msg
+ * @sig:    Signature of @digest by @key
+ * @dir:    Folder to save keys to
+ * @pubs:   Public keys of recurring signers
+ * @sigs:   Signatures of @digest by the signers of @pubs
+ * @signer: Signer of the next verification
+ * @items:  Batch of NB_BATCH signatures of @digest by @key
+ * @valid:  Results of @items
+ */
+
+typedef struct fixture_s
+{
+	EC_KEY *key;
+	uint8_t pub[EC_PUB_LEN];
+	int8_t msg[1024];
+	uint8_t digest[SHA256_DIGEST_LENGTH];
+	sig_t sig;
+	char dir[32];
+	uint8_t pubs[NB_SIGNERS][EC_PUB_LEN];
+	sig_t sigs[NB_SIGNERS];
+	uint32_t signer;
+	ec_verify_item_t items[NB_BATCH];
+	int valid[NB_BATCH];
+} fixture_t;
+
+/**
+ * _sha256 - Hashes a 1 KiB message
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _sha256(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+
+	while (iters--)
+		HBLK_BENCH_KEEP(sha256(f->msg, sizeof(f->msg), f->digest));
+}
+
+/**
+ * _ec_create - Creates and frees a key pair
+ *
+ * @arg: Unused
+ * @iters: Number of operations
+ */
+static void _ec_create(void *arg, uint64_t iters)
+{
+	(void)arg;
+	while (iters--)
+		EC_KEY_free(ec_create());
+}
+
+/**
+ * _ec_to_pub - Extracts the public key of a key pair
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _ec_to_pub(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+
+	while (iters--)
+		HBLK_BENCH_KEEP(ec_to_pub(f->key, f->pub));
+}
+
+/**
+ * _ec_from_pub - Creates and frees a key from a public key
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _ec_from_pub(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+
+	while (iters--)
+		EC_KEY_free(ec_from_pub(f->pub));
+}
+
+/**
+ * _ec_sign - Signs a digest
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _ec_sign(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+	sig_t sig;
+
+	while (iters--)
+		HBLK_BENCH_KEEP(ec_sign(f->key, f->digest, sizeof(f->digest),
+					&sig));
+}
+
+/**
+ * _ec_verify - Verifies the signature of a digest
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _ec_verify(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+	int valid;
+
+	while (iters--)
+	{
+		valid = ec_verify(f->key, f->digest, sizeof(f->digest),
+				  &f->sig);
+		HBLK_BENCH_KEEP(valid);
+	}
+}
+
+/**
+ * _verify_signers - Verifies a signature from one of the recurring
+ * signers, starting from its public key
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _verify_signers(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+	EC_KEY *key;
+	int valid;
+
+	while (iters--)
+	{
+		key = ec_from_pub(f->pubs[f->signer]);
+		valid = ec_verify(key, f->digest, sizeof(f->digest),
+				  &f->sigs[f->signer]);
+		HBLK_BENCH_KEEP(valid);
+		EC_KEY_free(key);
+		f->signer = (f->signer + 1) % NB_SIGNERS;
+	}
+}
+
+/**
+ * _verify_batch - Verifies a batch of NB_BATCH signatures
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _verify_batch(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+
+	while (iters--)
+		ec_verify_batch(f->items, NB_BATCH, f->valid);
+}
+
+/**
+ * _verify_scaling - Runs the batch case with 1 thread, then twice as many
+ * until every online CPU is used
+ *
+ * @bench: Benchmark run
+ * @f: Fixture
+ *
+ * Return: 0 on success, -1 on failure
+ */
+static int _verify_scaling(hblk_bench_t *bench, fixture_t *f)
+{
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+	char name[48];
+	long threads;
+	int i, ret = 0;
+
+	for (i = 0; i < NB_BATCH; i++)
+	{
+		f->items[i].key = f->key;
+		f->items[i].msg = f->digest;
+		f->items[i].msglen = sizeof(f->digest);
+		f->items[i].sig = &f->sig;
+	}
+	for (threads = 1; !ret && threads <= online; threads *= 2)
+	{
+		if (threads * 2 > online)
+			threads = online;
+		sprintf(name, "verify_batch/%d/t%ld", NB_BATCH, threads);
+		ret = hblk_verify_pool_init(threads) < 0 ? -1 :
+			hblk_bench_run(bench, name, _verify_batch, f);
+	}
+	hblk_verify_pool_destroy();
+
+	return (ret);
+}
+
+/**
+ * _ec_save_load - Saves a key pair to a folder and loads it back
+ *
+ * @arg: Fixture
+ * @iters: Number of operations
+ */
+static void _ec_save_load(void *arg, uint64_t iters)
+{
+	fixture_t *f = arg;
+
+	while (iters--)
+	{
+		ec_save(f->key, f->dir);
+		EC_KEY_free(ec_load(f->dir));
+	}
+}
+
+/**
+ * main - Runs every case of libhblk_crypto
+ *
+ * @ac: Arguments count
+ * @av: Arguments vector, see hblk_bench_init()
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(int ac, char **av)
+{
+	static fixture_t f;
+	hblk_bench_t bench;
+	EC_KEY *key;
+	char path[64];
+	int ret;
+
+	if (hblk_bench_init(&bench, ac, av) != 0)
+		return (EXIT_FAILURE);
+	f.key = ec_create();
+	ec_to_pub(f.key, f.pub);
+	memset(f.msg, 'H', sizeof(f.msg));
+	sha256(f.msg, sizeof(f.msg), f.digest);
+	ec_sign(f.key, f.digest, sizeof(f.digest), &f.sig);
+	sprintf(f.dir, "/tmp/hblk_bench.%d", (int)getpid());
+	for (ret = 0; ret < NB_SIGNERS; ret++)
+	{
+		key = ec_create();
+		ec_to_pub(key, f.pubs[ret]);
+		ec_sign(key, f.digest, sizeof(f.digest), &f.sigs[ret]);
+		EC_KEY_free(key);
+	}
+
+	ret = hblk_bench_run(&bench, "sha256/1024", _sha256, &f) |
+		hblk_bench_run(&bench, "ec_create", _ec_create, &f) |
+		hblk_bench_run(&bench, "ec_to_pub", _ec_to_pub, &f) |
+		hblk_bench_run(&bench, "ec_from_pub", _ec_from_pub, &f) |
+		hblk_bench_run(&bench, "ec_sign", _ec_sign, &f) |
+		hblk_bench_run(&bench, "ec_verify", _ec_verify, &f) |
+		hblk_bench_run(&bench, "verify_signers/uncached",
+			       _verify_signers, &f) |
+		hblk_key_cache_init(HBLK_KEY_CACHE_SIZE) |
+		hblk_bench_run(&bench, "ec_from_pub/cached", _ec_from_pub,
+			       &f) |
+		hblk_bench_run(&bench, "verify_signers/cached",
+			       _verify_signers, &f) |
+		hblk_key_cache_init(0) |
+		_verify_scaling(&bench, &f) |
+		hblk_sig_cache_init(HBLK_SIG_CACHE_SIZE) |
+		hblk_bench_run(&bench, "ec_verify/sig_cache", _ec_verify, &f) |
+		hblk_bench_run(&bench, "verify_batch/256/sig_cache",
+			       _verify_batch, &f) |
+		hblk_sig_cache_init(0) |
+		hblk_bench_run(&bench, "ec_save_load", _ec_save_load, &f) |
+		hblk_bench_finish(&bench);
+
+	sprintf(path, "%s/%s", f.dir, PRI_FILENAME);
+	remove(path);
+	sprintf(path, "%s/%s", f.dir, PUB_FILENAME);
+	remove(path);
+	rmdir(f.dir);
+	EC_KEY_free(f.key);
+	return (ret ? EXIT_FAILURE : EXIT_SUCCESS);
+}
@@ -1,54 +1,100 @@
-#include "hblk_crypto.h"
+#include "hblk_key_cache.h"
+
+static EC_GROUP *ec_group;
+static pthread_once_t ec_group_once = PTHREAD_ONCE_INIT;
 
 /**
- * ec_from_pub - program that creates an EC_KEY structure from a public key
- *
- * @pub: the array containing the public key to be converted
+ * group_create - program that creates the shared secp256k1 group
  *
- * Return: a pointer to the created EC_KEY structure upon success,
- *         or NULL upon failure
+ * Return: nothing (void)
  */
 
-EC_KEY *ec_from_pub(uint8_t const pub[EC_PUB_LEN])
+static void group_create(void)
 {
-	EC_KEY *key;
-	EC_GROUP *group;
-	EC_POINT *point;
+	ec_group = EC_GROUP_new_by_curve_name(EC_CURVE);
+}
 
-	if (pub == NULL)
-		return (NULL);
 
-	key = EC_KEY_new_by_curve_name(EC_CURVE);
 
-	if (key == NULL)
-		return (NULL);
+/**
+ * hblk_ec_group - program that provides the group of the EC_CURVE curve
+ *
+ * the group is created on first use and never modified afterwards, so it
+ * is shared by every thread instead of being built for every key
+ *
+ * Return: a pointer to the group, or NULL if it could not be created
+ */
 
-	group = EC_GROUP_new_by_curve_name(EC_CURVE);
+EC_GROUP const *hblk_ec_group(void)
+{
+	pthread_once(&ec_group_once, group_create);
+
+	return (ec_group);
+}
 
-	if (group == NULL)
-	{
-		EC_KEY_free(key);
-		return (NULL);
-	}
 
-	point = EC_POINT_new(group);
 
-	if (point == NULL)
+/**
+ * key_decode - program that makes a key from a public key
+ *
+ * @pub: the public key, in uncompressed octet string form
+ *
+ * Return: a pointer to the new key, or NULL if @pub is not a point of the
+ *         curve or on allocation failure
+ */
+
+static EC_KEY *key_decode(uint8_t const pub[EC_PUB_LEN])
+{
+	EC_GROUP const *group = hblk_ec_group();
+	EC_KEY *key = NULL;
+	EC_POINT *point = NULL;
+
+	if (group)
 	{
-		EC_GROUP_free(group);
-		EC_KEY_free(key);
-		return (NULL);
+		key = EC_KEY_new();
+		point = EC_POINT_new(group);
 	}
-
-	if (!EC_POINT_oct2point(group, point, pub, EC_PUB_LEN,
-				NULL) || !EC_KEY_set_public_key(key, point))
+	if (!key || !point || !EC_KEY_set_group(key, group) ||
+	    !EC_POINT_oct2point(group, point, pub, EC_PUB_LEN, NULL) ||
+	    !EC_KEY_set_public_key(key, point))
 	{
-		EC_POINT_free(point);
-		EC_GROUP_free(group);
 		EC_KEY_free(key);
-		return (NULL);
+		key = NULL;
 	}
 	EC_POINT_free(point);
-	EC_GROUP_free(group);
+
+	return (key);
+}
+
+
+
+/**
+ * ec_from_pub - program that creates an EC_KEY structure from a public key
+ *
+ * when the key cache is enabled (see hblk_key_cache_init()), the key of a
+ * recurring public key is not decoded again: a new reference to the
+ * cached key is returned instead, which the caller releases with
+ * EC_KEY_free() as usual but must not modify
+ *
+ * @pub: the array containing the public key to be converted
+ *
+ * Return: a pointer to the created EC_KEY structure upon success,
+ *         or NULL upon failure
+ */
+
+EC_KEY *ec_from_pub(uint8_t const pub[EC_PUB_LEN])
+{
+	EC_KEY *key;
+
+	if (pub == NULL)
+		return (NULL);
+
+	key = hblk_key_cache_get(pub);
+	if (key)
+		return (key);
+
+	key = key_decode(pub);
+	hblk_key_cache_put(pub, key);
+
 	return (key);
 }
@@ -16,16 +16,25 @@
 uint8_t *ec_sign(EC_KEY const *key, uint8_t const *msg, size_t msglen,
 		 sig_t *sig)
 {
+	uint64_t start, span;
+	unsigned int len = 0;
+	int ret;
+
 	if (!key || !msg || !sig)
 		return (NULL);
 
 	sig->len = 0;
+	start = HBLK_STAT_NOW();
+	span = HBLK_TRACE_BEGIN();
 
 	/* Perform the ECDSA signature */
-	if (ECDSA_sign(0, msg, msglen, sig->sig, (unsigned int *)&(sig->len),
-		       (EC_KEY *)key) != 1)
+	ret = ECDSA_sign(0, msg, msglen, sig->sig, &len, (EC_KEY *)key);
+	sig->len = len;
 
-		return (NULL);
+	HBLK_STAT_ADD(HBLK_STAT_EC_SIGN, 1);
+	HBLK_STAT_ELAPSED(HBLK_STAT_EC_SIGN_NS, start);
+	HBLK_LATENCY(HBLK_LAT_EC_SIGN, start);
+	HBLK_TRACE_END("ec_sign", span);
 
-	return (sig->sig);
+	return (ret == 1 ? sig->sig : NULL);
 }
@@ -1,4 +1,4 @@
-#include "hblk_crypto.h"
+#include "hblk_sig_cache.h"
 
 /**
  * ec_verify - program that checks the signature of a given set of bytes
@@ -9,18 +9,39 @@
  * @msglen: the number of bytes to verify
  * @sig: a pointer to the signature to be checked
  *
+ * when the signature cache is enabled (see hblk_sig_cache_init()), a
+ * signature found valid before is accepted from the cache, without
+ * another ECDSA verification
+ *
  * Return: 1 if the signature is valid, 0 otherwise
  */
 
 int ec_verify(EC_KEY const *key, uint8_t const *msg, size_t msglen,
 	      sig_t const *sig)
 {
+	uint8_t id[SHA256_DIGEST_LENGTH];
+	uint64_t start, span;
+	int ret, cached;
+
 	if (!key || !msg || !sig)
 		return (0);
 
+	cached = hblk_sig_cache_id(key, msg, msglen, sig, id) == 0;
+	if (cached && hblk_sig_cache_find(id))
+		return (1);
+
+	start = HBLK_STAT_NOW();
+	span = HBLK_TRACE_BEGIN();
+
 	/* Perform the ECDSA signature verification */
-	if (ECDSA_verify(0, msg, msglen, sig->sig, sig->len, (EC_KEY *)key) != 1)
-		return (0);
+	ret = ECDSA_verify(0, msg, msglen, sig->sig, sig->len, (EC_KEY *)key);
+
+	HBLK_STAT_ADD(HBLK_STAT_EC_VERIFY, 1);
+	HBLK_STAT_ELAPSED(HBLK_STAT_EC_VERIFY_NS, start);
+	HBLK_LATENCY(HBLK_LAT_EC_VERIFY, start);
+	HBLK_TRACE_END("ec_verify", span);
+	if (cached && ret == 1)
+		hblk_sig_cache_add(id);
 
-	return (1);
+	return (ret == 1);
 }
@@ -0,0 +1,83 @@
+#include "hblk_verify_pool.h"
+
+/**
+ * hblk_verify_pool_work - program that verifies the items of the current
+ * batch until none is left
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_verify_pool_work(void)
+{
+	hblk_verify_pool_t *pool = &hblk_verify_pool;
+	ec_verify_item_t const *item;
+	size_t i;
+
+	while ((i = atomic_fetch_add(&pool->next, 1)) < pool->count)
+	{
+		item = &pool->items[i];
+		pool->results[i] = ec_verify(item->key, item->msg,
+					     item->msglen, item->sig);
+		if (pool->results[i])
+			atomic_fetch_add(&pool->valid, 1);
+	}
+}
+
+
+
+/**
+ * ec_verify_batch - program that verifies a batch of signatures over the
+ * threads of a pool
+ *
+ * the calling thread verifies its share too; batches from several
+ * threads are verified one after the other (see hblk_verify_pool_init()
+ * for the number of threads)
+ *
+ * @items: the signatures to verify, with their key and message
+ * @count: the number of @items
+ * @results: an array of @count results, set to 1 for each valid
+ *           signature and 0 for each invalid one, as ec_verify() does
+ *
+ * Return: the number of valid signatures, or -1 if @items or @results is
+ *         NULL
+ */
+
+int ec_verify_batch(ec_verify_item_t const *items, size_t count,
+		    int *results)
+{
+	hblk_verify_pool_t *pool = &hblk_verify_pool;
+	uint64_t span = HBLK_TRACE_BEGIN();
+	size_t valid;
+
+	if (!items || !results)
+		return (-1);
+
+	pthread_mutex_lock(&pool->batch);
+	if (!pool->started)
+		hblk_verify_pool_start(0);
+	pthread_mutex_lock(&pool->lock);
+	pool->items = items;
+	pool->results = results;
+	pool->count = count;
+	atomic_store(&pool->next, 0);
+	atomic_store(&pool->valid, 0);
+	if (count >= HBLK_VERIFY_MIN_BATCH && pool->nthreads)
+	{
+		pool->active = pool->nthreads;
+		pool->gen++;
+		pthread_cond_broadcast(&pool->work);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	hblk_verify_pool_work();
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->active)
+		pthread_cond_wait(&pool->done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+	valid = atomic_load(&pool->valid);
+	pthread_mutex_unlock(&pool->batch);
+	HBLK_TRACE_END("ec_verify_batch", span);
+
+	return ((int)valid);
+}
@@ -0,0 +1,176 @@
+#include "hblk_bench.h"
+#include "hblk_stats.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * bench_compare - program that orders two repetition times
+ *
+ * @a: a pointer to the first time
+ * @b: a pointer to the second time
+ *
+ * Return: a negative, zero or positive value as @a is faster than, as
+ *         fast as, or slower than @b
+ */
+
+static int bench_compare(void const *a, void const *b)
+{
+	double x = *(double const *)a, y = *(double const *)b;
+
+	return ((x > y) - (x < y));
+}
+
+
+
+/**
+ * bench_calibrate - program that warms a case up and sizes its batch
+ *
+ * the batch grows, at most tenfold per step, until running it takes at
+ * least the duration of a repetition, so the clock reads are amortized
+ *
+ * @bench: a pointer to the settings of the run
+ * @fn: the operation
+ * @arg: the fixture of the case
+ *
+ * Return: the number of operations to time per repetition
+ */
+
+static uint64_t bench_calibrate(hblk_bench_t const *bench,
+				hblk_bench_fn_t fn, void *arg)
+{
+	uint64_t batch = 1, start, elapsed, end = hblk_stat_now() +
+		bench->warmup;
+
+	/* caches, branch predictors and clock frequency settle first */
+	do {
+		fn(arg, 1);
+	} while (hblk_stat_now() < end);
+
+	for (;;)
+	{
+		start = hblk_stat_now();
+		fn(arg, batch);
+		elapsed = hblk_stat_now() - start;
+		if (elapsed >= bench->rep_ns || batch >= UINT32_MAX)
+			break;
+		if (elapsed && bench->rep_ns / elapsed < 10)
+			batch = batch * bench->rep_ns / elapsed + 1;
+		else
+			batch *= 10;
+	}
+
+	return (batch);
+}
+
+
+
+/**
+ * bench_summary - program that summarizes the repetitions of a case
+ *
+ * @samples: the time of every repetition, in nanoseconds per operation,
+ *           sorted on return
+ * @result: a pointer to the result to fill, @result->reps being the
+ *          number of @samples
+ *
+ * Return: nothing (void)
+ */
+
+static void bench_summary(double *samples, hblk_bench_result_t *result)
+{
+	uint32_t i, n = result->reps;
+	double sum = 0, squares = 0;
+
+	qsort(samples, n, sizeof(*samples), bench_compare);
+	for (i = 0; i < n; i++)
+		sum += samples[i];
+	result->mean = sum / n;
+	for (i = 0; i < n; i++)
+		squares += (samples[i] - result->mean) *
+			(samples[i] - result->mean);
+	result->stddev = n > 1 ? sqrt(squares / (n - 1)) : 0;
+	result->min = samples[0];
+	result->max = samples[n - 1];
+	result->median = n % 2 ? samples[n / 2] :
+		(samples[n / 2 - 1] + samples[n / 2]) / 2;
+}
+
+
+
+/**
+ * bench_report - program that prints the summary of a case
+ *
+ * @bench: a pointer to the settings and output of the run
+ * @result: a pointer to the summary
+ *
+ * Return: nothing (void)
+ */
+
+static void bench_report(hblk_bench_t *bench,
+			 hblk_bench_result_t const *result)
+{
+	if (bench->text)
+		fprintf(bench->text, "%-24s %9lu %12.1f %12.1f %12.1f %5.1f%% "
+			"%12.1f\n", result->name, (unsigned long)result->batch,
+			result->min, result->median, result->mean,
+			result->mean ? 100 * result->stddev / result->mean : 0,
+			result->max);
+	if (bench->json)
+		fprintf(bench->json, "%s\n{\"name\":\"%s\",\"batch\":%lu,"
+			"\"reps\":%u,\"min_ns\":%.3f,\"median_ns\":%.3f,"
+			"\"mean_ns\":%.3f,\"stddev_ns\":%.3f,\"max_ns\":%.3f,"
+			"\"ops_per_sec\":%.1f}", bench->ncases ? "," : "",
+			result->name, (unsigned long)result->batch,
+			result->reps, result->min, result->median,
+			result->mean, result->stddev, result->max,
+			result->median ? 1e9 / result->median : 0);
+	bench->ncases++;
+}
+
+
+
+/**
+ * hblk_bench_run - program that benchmarks a case
+ *
+ * the case is skipped if its name does not match the filter of the run
+ *
+ * @bench: a pointer to the settings and output of the run, see
+ *         hblk_bench_init()
+ * @name: the name of the case
+ * @fn: the operation, run in batches
+ * @arg: the fixture passed to @fn, set up by the caller
+ *
+ * Return: 0 on success, -1 on failure
+ */
+
+int hblk_bench_run(hblk_bench_t *bench, char const *name,
+		   hblk_bench_fn_t fn, void *arg)
+{
+	hblk_bench_result_t result;
+	uint64_t start;
+	double *samples;
+	uint32_t i;
+
+	if (!bench || !name || !fn || !bench->reps)
+		return (-1);
+	if (bench->filter && !strstr(name, bench->filter))
+		return (0);
+
+	samples = malloc(bench->reps * sizeof(*samples));
+	if (!samples)
+		return (-1);
+	result.name = name;
+	result.reps = bench->reps;
+	result.batch = bench_calibrate(bench, fn, arg);
+	for (i = 0; i < bench->reps; i++)
+	{
+		start = hblk_stat_now();
+		fn(arg, result.batch);
+		samples[i] = (double)(hblk_stat_now() - start) / result.batch;
+	}
+	bench_summary(samples, &result);
+	free(samples);
+	bench_report(bench, &result);
+
+	return (0);
+}
@@ -0,0 +1,100 @@
+#ifndef HBLK_BENCH_H
+#define HBLK_BENCH_H
+
+
+#include <stdio.h>
+#include <stdint.h>
+
+
+
+/* Defaults of the harness, overridden on the command line */
+# define HBLK_BENCH_REPS        20
+# define HBLK_BENCH_REP_NS      10000000
+# define HBLK_BENCH_WARMUP_NS   100000000
+
+/*
+ * Keeps the compiler from optimizing away a result the benchmark does not
+ * otherwise use
+ */
+# define HBLK_BENCH_KEEP(ptr) __asm__ volatile("" : : "g"(ptr) : "memory")
+
+
+/**
+ * hblk_bench_fn_t - Benchmarked operation
+ *
+ * @arg:   Fixture of the case, set up before timing starts
+ * @iters: Number of times to run the operation
+ */
+
+typedef void (*hblk_bench_fn_t)(void *arg, uint64_t iters);
+
+
+
+/**
+ * struct hblk_bench_result_s - Summary of the repetitions of a case
+ *
+ * @name:   Name of the case
+ * @batch:  Number of operations timed per repetition
+ * @reps:   Number of repetitions
+ * @min:    Fastest repetition, in nanoseconds per operation
+ * @median: Median repetition, in nanoseconds per operation
+ * @mean:   Mean of the repetitions, in nanoseconds per operation
+ * @stddev: Standard deviation of the repetitions, in nanoseconds
+ * @max:    Slowest repetition, in nanoseconds per operation
+ */
+
+typedef struct hblk_bench_result_s
+{
+	char const  *name;
+	uint64_t    batch;
+	uint32_t    reps;
+	double      min;
+	double      median;
+	double      mean;
+	double      stddev;
+	double      max;
+} hblk_bench_result_t;
+
+
+
+/**
+ * struct hblk_bench_s - Settings and output of a benchmark run
+ *
+ * @reps:    Number of timed repetitions per case
+ * @rep_ns:  Minimum duration of a repetition, the batch of operations is
+ *           grown until it is reached
+ * @warmup:  Time spent running a case before timing it, in nanoseconds
+ * @filter:  Only the cases whose name contains it run, if not NULL
+ * @cpu:     CPU the run is pinned to, -1 if not pinned
+ * @text:    Stream the summary table is printed to, or NULL
+ * @json:    Stream the JSON document is written to, or NULL
+ * @ncases:  Number of cases run so far
+ *
+ * Description: Every case is warmed up, its batch calibrated so that a
+ * repetition lasts at least @rep_ns, then timed @reps times; the summary
+ * is computed from the per-operation time of each repetition. The JSON
+ * document records the machine context (CPU model, frequency governor,
+ * affinity) along with the results, so that runs of two builds can be
+ * compared.
+ */
+
+typedef struct hblk_bench_s
+{
+	uint32_t    reps;
+	uint64_t    rep_ns;
+	uint64_t    warmup;
+	char const  *filter;
+	int         cpu;
+	FILE        *text;
+	FILE        *json;
+	uint32_t    ncases;
+} hblk_bench_t;
+
+
+int hblk_bench_init(hblk_bench_t *bench, int argc, char *argv[]);
+int hblk_bench_run(hblk_bench_t *bench, char const *name,
+		   hblk_bench_fn_t fn, void *arg);
+int hblk_bench_finish(hblk_bench_t *bench);
+
+
+#endif /* HBLK_BENCH_H */
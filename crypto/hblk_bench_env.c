@@ -0,0 +1,234 @@
+#define _GNU_SOURCE
+#include "hblk_bench.h"
+#include "hblk_hist.h"
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * env_read - program that reads a setting of the machine from a file
+ *
+ * quotes and backslashes are dropped, so the value can be written in JSON
+ *
+ * @path: the path to the file, in /proc or /sys
+ * @key: the start of the line to read, or NULL for the first line
+ * @buf: the buffer to store the value in
+ * @size: the size of @buf
+ *
+ * Return: @buf, holding "unknown" if the setting could not be read
+ */
+
+static char *env_read(char const *path, char const *key, char *buf,
+		      size_t size)
+{
+	FILE *file = fopen(path, "r");
+	char *line = NULL, *value = NULL, *dst;
+	size_t len = 0;
+
+	while (file && !value && getline(&line, &len, file) != -1)
+		if (!key || !strncmp(line, key, strlen(key)))
+			value = key && strchr(line, ':') ?
+				strchr(line, ':') + 2 : line;
+	for (dst = buf; value && *value && *value != '\n' &&
+	     dst + 1 < buf + size; value++)
+		if (*value != '"' && *value != '\\')
+			*dst++ = *value;
+	*dst = '\0';
+	if (!*buf)
+		snprintf(buf, size, "unknown");
+	free(line);
+	if (file)
+		fclose(file);
+
+	return (buf);
+}
+
+
+
+/**
+ * bench_context - program that reports the machine a run happens on
+ *
+ * frequency scaling and migrations between CPUs are the main sources of
+ * noise, so a note is printed when either is not under control
+ *
+ * @bench: a pointer to the settings and output of the run
+ *
+ * Return: nothing (void)
+ */
+
+static void bench_context(hblk_bench_t *bench)
+{
+	char model[128], mhz[32], governor[32], turbo[32];
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+	cpu_set_t set;
+	int allowed;
+
+	env_read("/proc/cpuinfo", "model name", model, sizeof(model));
+	env_read("/proc/cpuinfo", "cpu MHz", mhz, sizeof(mhz));
+	env_read("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor",
+		 NULL, governor, sizeof(governor));
+	env_read("/sys/devices/system/cpu/intel_pstate/no_turbo", NULL, turbo,
+		 sizeof(turbo));
+	allowed = sched_getaffinity(0, sizeof(set), &set) ? -1 :
+		CPU_COUNT(&set);
+
+	if (bench->text)
+	{
+		fprintf(bench->text, "cpu: %s (%s MHz)\ngovernor: %s, "
+			"no_turbo: %s, cpus: %d of %ld allowed, pinned: %d\n",
+			model, mhz, governor, turbo, allowed, online,
+			bench->cpu);
+		if (strcmp(governor, "performance") &&
+		    strcmp(governor, "unknown"))
+			fprintf(bench->text, "note: the frequency governor is "
+				"not \"performance\", timings may drift\n");
+		if (bench->cpu < 0)
+			fprintf(bench->text, "note: not pinned to a CPU (-c), "
+				"migrations add noise\n");
+		fprintf(bench->text, "%-24s %9s %12s %12s %12s %6s %12s\n",
+			"case (ns/op)", "batch", "min", "median", "mean",
+			"cv", "max");
+	}
+	if (bench->json)
+		fprintf(bench->json, "{\"context\":{\"cpu\":\"%s\","
+			"\"mhz\":\"%s\",\"governor\":\"%s\","
+			"\"no_turbo\":\"%s\","
+			"\"cpus_online\":%ld,\"cpus_allowed\":%d,\"pinned\":%d,"
+			"\"reps\":%u,\"rep_ns\":%lu,\"warmup_ns\":%lu},\n"
+			"\"benchmarks\":[", model, mhz, governor, turbo, online,
+			allowed, bench->cpu, bench->reps,
+			(unsigned long)bench->rep_ns,
+			(unsigned long)bench->warmup);
+}
+
+
+
+/**
+ * bench_options - program that parses the options of a benchmark program
+ *
+ * -r reps, -t repetition ms, -w warmup ms, -f filter, -c cpu,
+ * -j JSON path ("-" for stdout, which then silences the table), -q
+ *
+ * @bench: a pointer to the settings to fill
+ * @argc: the number of arguments
+ * @argv: the arguments
+ *
+ * Return: the path to write the JSON document to, "" for none, or NULL
+ *         on an invalid option
+ */
+
+static char const *bench_options(hblk_bench_t *bench, int argc,
+				 char *argv[])
+{
+	char const *json = "";
+	int opt;
+
+	while ((opt = getopt(argc, argv, "r:t:w:f:c:j:q")) != -1)
+	{
+		if (opt == 'r')
+			bench->reps = strtoul(optarg, NULL, 10);
+		else if (opt == 't')
+			bench->rep_ns = strtoull(optarg, NULL, 10) * 1000000;
+		else if (opt == 'w')
+			bench->warmup = strtoull(optarg, NULL, 10) * 1000000;
+		else if (opt == 'f')
+			bench->filter = optarg;
+		else if (opt == 'c')
+			bench->cpu = atoi(optarg);
+		else if (opt == 'j')
+			json = optarg;
+		else if (opt == 'q')
+			bench->text = NULL;
+		else
+			return (NULL);
+	}
+	if (!strcmp(json, "-"))
+		bench->text = NULL;
+
+	return (bench->reps ? json : NULL);
+}
+
+
+
+/**
+ * hblk_bench_init - program that sets a benchmark run up from the command
+ * line
+ *
+ * the run is pinned to a CPU if asked to, the context of the machine is
+ * reported, and the latency histograms are reset
+ *
+ * @bench: a pointer to the settings and output of the run
+ * @argc: the number of arguments of the program
+ * @argv: the arguments of the program
+ *
+ * Return: 0 on success, -1 on failure (a usage message is then printed)
+ */
+
+int hblk_bench_init(hblk_bench_t *bench, int argc, char *argv[])
+{
+	char const *json;
+	cpu_set_t set;
+
+	memset(bench, 0, sizeof(*bench));
+	bench->reps = HBLK_BENCH_REPS;
+	bench->rep_ns = HBLK_BENCH_REP_NS;
+	bench->warmup = HBLK_BENCH_WARMUP_NS;
+	bench->cpu = -1;
+	bench->text = stdout;
+	json = bench_options(bench, argc, argv);
+	CPU_ZERO(&set);
+	if (bench->cpu >= 0)
+		CPU_SET(bench->cpu, &set);
+	if (json && *json)
+		bench->json = strcmp(json, "-") ? fopen(json, "w") : stdout;
+	if (!json || (*json && !bench->json) || (bench->cpu >= 0 &&
+	    sched_setaffinity(0, sizeof(set), &set)))
+	{
+		fprintf(stderr, "Usage: %s [-r reps] [-t rep_ms] [-w warmup_ms]"
+			" [-f filter] [-c cpu] [-j file.json|-] [-q]\n",
+			argv[0]);
+		if (bench->json && bench->json != stdout)
+			fclose(bench->json);
+		return (-1);
+	}
+
+	bench_context(bench);
+	hblk_latency_reset();
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_bench_finish - program that completes a benchmark run
+ *
+ * the per-call latency percentiles recorded during the run follow the
+ * summary table, and the JSON document is closed
+ *
+ * @bench: a pointer to the settings and output of the run
+ *
+ * Return: 0 on success, -1 if the JSON document could not be written
+ */
+
+int hblk_bench_finish(hblk_bench_t *bench)
+{
+	int ret = 0;
+
+	if (bench->text)
+	{
+		fprintf(bench->text, "per-call latencies:\n");
+		hblk_latency_print(bench->text);
+	}
+	if (bench->json)
+	{
+		fprintf(bench->json, "\n]}\n");
+		ret = ferror(bench->json) ? -1 : 0;
+		if (bench->json != stdout && fclose(bench->json))
+			ret = -1;
+		bench->json = NULL;
+	}
+
+	return (ret);
+}
@@ -12,6 +12,9 @@
 #include <openssl/pem.h>
 #include <errno.h>
 #include <sys/stat.h>
+#include "hblk_stats.h"
+#include "hblk_hist.h"
+#include "hblk_trace.h"
 
 
 
@@ -43,6 +46,25 @@ typedef struct sig_s
 
 
 
+/**
+ * struct ec_verify_item_s - Signature to verify in a batch
+ *
+ * @key:    Public key of the signer
+ * @msg:    Signed message
+ * @msglen: Size of @msg
+ * @sig:    Signature of @msg
+ */
+
+typedef struct ec_verify_item_s
+{
+	EC_KEY const    *key;
+	uint8_t const   *msg;
+	size_t      msglen;
+	sig_t const     *sig;
+} ec_verify_item_t;
+
+
+
 /* task 0 */
 uint8_t *sha256(int8_t const *s, size_t len,
 		uint8_t digest[SHA256_DIGEST_LENGTH]);
@@ -73,5 +95,8 @@ uint8_t *ec_sign(EC_KEY const *key, uint8_t const *msg, size_t msglen,
 int ec_verify(EC_KEY const *key, uint8_t const *msg, size_t msglen,
 	      sig_t const *sig);
 
+int ec_verify_batch(ec_verify_item_t const *items, size_t count,
+		    int *results);
+
 
 #endif /* HBLK_CRYPTO_H */
@@ -0,0 +1,160 @@
+#include "hblk_hist.h"
+
+/* Relaxed atomic accessors: a histogram has a single writer */
+#define LOAD(v) atomic_load_explicit(&(v), memory_order_relaxed)
+#define STORE(v, x) atomic_store_explicit(&(v), (x), memory_order_relaxed)
+
+/**
+ * hist_index - program that computes the bucket of a value
+ *
+ * values below 2 * HBLK_HIST_SUB have a bucket each; above, the
+ * HBLK_HIST_SUB_BITS bits below the most significant one pick one of the
+ * HBLK_HIST_SUB buckets of its power of 2
+ *
+ * @value: the value
+ *
+ * Return: the index of the bucket of @value
+ */
+
+static unsigned int hist_index(uint64_t value)
+{
+	unsigned int shift;
+
+	if (value < 2 * HBLK_HIST_SUB)
+		return (value);
+
+	shift = 63 - __builtin_clzll(value) - HBLK_HIST_SUB_BITS;
+
+	return (shift * HBLK_HIST_SUB + (value >> shift));
+}
+
+
+
+/**
+ * hist_highest - program that computes the highest value of a bucket
+ *
+ * @index: the index of the bucket
+ *
+ * Return: the highest value falling in the bucket
+ */
+
+static uint64_t hist_highest(unsigned int index)
+{
+	unsigned int shift;
+	uint64_t sub;
+
+	if (index < 2 * HBLK_HIST_SUB)
+		return (index);
+
+	shift = (index >> HBLK_HIST_SUB_BITS) - 1;
+	sub = (index & (HBLK_HIST_SUB - 1)) + HBLK_HIST_SUB;
+
+	/* wraps to UINT64_MAX for the last bucket */
+	return (((sub + 1) << shift) - 1);
+}
+
+
+
+/**
+ * hblk_hist_record - program that records a value in a histogram
+ *
+ * only one thread may record in a given histogram
+ *
+ * @hist: a pointer to the histogram
+ * @value: the value to record
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_hist_record(hblk_hist_t *hist, uint64_t value)
+{
+	unsigned int index = hist_index(value);
+	uint64_t count = LOAD(hist->count);
+
+	STORE(hist->counts[index], LOAD(hist->counts[index]) + 1);
+	STORE(hist->sum, LOAD(hist->sum) + value);
+	if (!count || value < LOAD(hist->min))
+		STORE(hist->min, value);
+	if (value > LOAD(hist->max))
+		STORE(hist->max, value);
+	STORE(hist->count, count + 1);
+}
+
+
+
+/**
+ * hblk_hist_merge - program that adds the values of a histogram to
+ * another
+ *
+ * only one thread may merge into, or record in, @dst at a time
+ *
+ * @dst: a pointer to the histogram to add to
+ * @src: a pointer to the histogram to add
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_hist_merge(hblk_hist_t *dst, hblk_hist_t const *src)
+{
+	uint64_t count = LOAD(src->count), min = LOAD(src->min);
+	uint64_t max = LOAD(src->max);
+	unsigned int i;
+
+	if (!count)
+		return;
+
+	for (i = 0; i < HBLK_HIST_BUCKETS; i++)
+		if (LOAD(src->counts[i]))
+			STORE(dst->counts[i],
+			      LOAD(dst->counts[i]) + LOAD(src->counts[i]));
+	STORE(dst->sum, LOAD(dst->sum) + LOAD(src->sum));
+	if (!LOAD(dst->count) || min < LOAD(dst->min))
+		STORE(dst->min, min);
+	if (max > LOAD(dst->max))
+		STORE(dst->max, max);
+	STORE(dst->count, LOAD(dst->count) + count);
+}
+
+
+
+/**
+ * hblk_hist_percentile - program that computes a percentile of the
+ * values of a histogram
+ *
+ * the value reported is the highest of its bucket, clamped to the
+ * recorded extrema, so it is never below the exact percentile
+ *
+ * @hist: a pointer to the histogram
+ * @percentile: the percentile, from 0 (minimum) to 100 (maximum)
+ *
+ * Return: the value below or at which @percentile % of the values fall,
+ *         0 if no value was recorded
+ */
+
+uint64_t hblk_hist_percentile(hblk_hist_t const *hist, double percentile)
+{
+	uint64_t count = LOAD(hist->count), max = LOAD(hist->max);
+	uint64_t min = LOAD(hist->min), rank, seen = 0, value;
+	unsigned int i;
+
+	if (!count)
+		return (0);
+	if (percentile <= 0)
+		return (min);
+	if (percentile >= 100)
+		return (max);
+
+	/* the rank of the value, rounded up */
+	rank = (uint64_t)(percentile / 100 * count);
+	rank += rank < percentile / 100 * count || !rank;
+	for (i = 0; i < HBLK_HIST_BUCKETS; i++)
+	{
+		seen += LOAD(hist->counts[i]);
+		if (seen < rank)
+			continue;
+		value = hist_highest(i);
+		return (value > max ? max : value < min ? min : value);
+	}
+
+	return (max);
+}
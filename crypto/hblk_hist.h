@@ -0,0 +1,126 @@
+#ifndef HBLK_HIST_H
+#define HBLK_HIST_H
+
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "hblk_stats.h"
+
+
+
+/*
+ * Every power of 2 is split into HBLK_HIST_SUB buckets, so a recorded
+ * value is reported within 1 / HBLK_HIST_SUB (about 3%) of its exact value,
+ * from 1 ns up to UINT64_MAX
+ */
+# define HBLK_HIST_SUB_BITS 5
+# define HBLK_HIST_SUB      (1 << HBLK_HIST_SUB_BITS)
+# define HBLK_HIST_BUCKETS  ((65 - HBLK_HIST_SUB_BITS) * HBLK_HIST_SUB)
+
+/* Per-call latencies (nanoseconds) recorded on the hot paths */
+# define HBLK_LAT_BLOCK_VALID   0
+# define HBLK_LAT_BLOCK_APPEND  1
+# define HBLK_LAT_EC_SIGN       2
+# define HBLK_LAT_EC_VERIFY     3
+# define HBLK_LAT_MAX           4
+
+/* Compiled out along with the counters, by -DHBLK_NO_STATS */
+# ifndef HBLK_NO_STATS
+#  define HBLK_LATENCY(id, start) \
+	hblk_latency_record((id), hblk_stat_now() - (start))
+# else
+#  define HBLK_LATENCY(id, start) ((void)(start))
+# endif
+
+
+/**
+ * struct hblk_hist_s - Log-bucketed histogram of values
+ *
+ * @count:  Number of values recorded
+ * @sum:    Sum of the values recorded
+ * @min:    Smallest value recorded, meaningless while @count is 0
+ * @max:    Largest value recorded
+ * @counts: Number of values recorded in every bucket
+ *
+ * Description: An HDR-style histogram: the buckets of a histogram only
+ * depend on HBLK_HIST_SUB_BITS, so histograms merge by adding their
+ * buckets. A single thread records into a histogram, with relaxed atomic
+ * loads and stores; any thread may read it at the same time.
+ */
+
+typedef struct hblk_hist_s
+{
+	_Atomic uint64_t    count;
+	_Atomic uint64_t    sum;
+	_Atomic uint64_t    min;
+	_Atomic uint64_t    max;
+	_Atomic uint64_t    counts[HBLK_HIST_BUCKETS];
+} hblk_hist_t;
+
+
+
+/**
+ * struct hblk_latency_slot_s - Latency histograms of a single thread
+ *
+ * @hists: Histogram of every latency; only the owning thread writes them
+ * @gen:   Value of the generation of the registry when @hists were last
+ *         cleared
+ * @next:  Next slot of the registry
+ */
+
+typedef struct hblk_latency_slot_s
+{
+	hblk_hist_t hists[HBLK_LAT_MAX];
+	_Atomic uint64_t    gen;
+	struct hblk_latency_slot_s  *next;
+} hblk_latency_slot_t;
+
+
+
+/**
+ * struct hblk_latency_s - Registry of the latency histograms of every
+ * thread
+ *
+ * @lock:    Protects @slots and @retired
+ * @once:    Creates @key on first use
+ * @key:     Releases the slot of a thread when it exits
+ * @gen:     Generation, bumped by hblk_latency_reset()
+ * @slots:   Slots of the running threads
+ * @retired: Histograms of the threads that exited
+ *
+ * Description: Every thread records in its own slot, as hblk_stats does
+ * for the counters. A reset only bumps @gen: a thread clears its own slot
+ * when it next records, and readers skip the slots not cleared yet, so no
+ * thread ever writes the slot of another.
+ */
+
+typedef struct hblk_latency_s
+{
+	pthread_mutex_t     lock;
+	pthread_once_t      once;
+	pthread_key_t       key;
+	_Atomic uint64_t    gen;
+	hblk_latency_slot_t *slots;
+	hblk_hist_t retired[HBLK_LAT_MAX];
+} hblk_latency_t;
+
+
+extern hblk_latency_t hblk_latency;
+
+
+void hblk_hist_record(hblk_hist_t *hist, uint64_t value);
+void hblk_hist_merge(hblk_hist_t *dst, hblk_hist_t const *src);
+uint64_t hblk_hist_percentile(hblk_hist_t const *hist, double percentile);
+void hblk_hist_clear(hblk_hist_t *hist);
+void hblk_latency_record(unsigned int id, uint64_t ns);
+int hblk_latency_get(unsigned int id, hblk_hist_t *hist);
+char const *hblk_latency_name(unsigned int id);
+void hblk_latency_reset(void);
+void hblk_hist_print(FILE *stream, char const *name, hblk_hist_t const *hist);
+void hblk_latency_print(FILE *stream);
+
+
+#endif /* HBLK_HIST_H */
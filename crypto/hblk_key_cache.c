@@ -0,0 +1,142 @@
+#include "hblk_key_cache.h"
+
+hblk_key_cache_t hblk_key_cache = {
+	PTHREAD_MUTEX_INITIALIZER, NULL, NULL, 0, 0, 0, 0, NULL, NULL
+};
+
+/**
+ * hblk_key_lru_unlink - program that removes an entry from the recency
+ * list of the cache
+ *
+ * the lock of the cache must be held
+ *
+ * @entry: a pointer to the entry
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_key_lru_unlink(hblk_key_entry_t *entry)
+{
+	if (entry->prev)
+		entry->prev->next = entry->next;
+	else
+		hblk_key_cache.head = entry->next;
+	if (entry->next)
+		entry->next->prev = entry->prev;
+	else
+		hblk_key_cache.tail = entry->prev;
+	entry->prev = entry->next = NULL;
+}
+
+
+
+/**
+ * hblk_key_lru_push - program that makes an entry the most recently used
+ * of the cache
+ *
+ * the lock of the cache must be held, and @entry must not be listed
+ *
+ * @entry: a pointer to the entry
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_key_lru_push(hblk_key_entry_t *entry)
+{
+	entry->prev = NULL;
+	entry->next = hblk_key_cache.head;
+	if (hblk_key_cache.head)
+		hblk_key_cache.head->prev = entry;
+	else
+		hblk_key_cache.tail = entry;
+	hblk_key_cache.head = entry;
+}
+
+
+
+/**
+ * cache_release - program that drops every key of the cache
+ *
+ * the lock of the cache must be held; the keys still referenced by
+ * callers of ec_from_pub() stay valid
+ *
+ * Return: nothing (void)
+ */
+
+static void cache_release(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < hblk_key_cache.count; i++)
+	{
+		EC_KEY_free(hblk_key_cache.entries[i].key);
+		hblk_key_cache.entries[i].key = NULL;
+	}
+	for (i = 0; hblk_key_cache.buckets && i <= hblk_key_cache.mask; i++)
+		hblk_key_cache.buckets[i] = NULL;
+	hblk_key_cache.count = 0;
+	hblk_key_cache.head = hblk_key_cache.tail = NULL;
+}
+
+
+
+/**
+ * hblk_key_cache_init - program that enables, resizes or disables the
+ * cache of the keys made by ec_from_pub()
+ *
+ * the keys cached so far are dropped
+ *
+ * @capacity: the maximum number of keys to cache (HBLK_KEY_CACHE_SIZE is
+ *            a sensible default), or 0 to disable the cache
+ *
+ * Return: 0 on success, -1 on failure (the cache is then disabled)
+ */
+
+int hblk_key_cache_init(uint32_t capacity)
+{
+	uint32_t buckets = 1;
+	int ret = 0;
+
+	while (buckets < capacity && buckets < (1U << 31))
+		buckets <<= 1;
+
+	pthread_mutex_lock(&hblk_key_cache.lock);
+	cache_release();
+	free(hblk_key_cache.entries);
+	free(hblk_key_cache.buckets);
+	hblk_key_cache.entries = capacity ?
+		calloc(capacity, sizeof(*hblk_key_cache.entries)) : NULL;
+	hblk_key_cache.buckets = capacity ?
+		calloc(buckets, sizeof(*hblk_key_cache.buckets)) : NULL;
+	hblk_key_cache.mask = buckets - 1;
+	hblk_key_cache.seed = hblk_stat_now() * 0x9e3779b97f4a7c15ULL;
+	hblk_key_cache.capacity = capacity;
+	if (capacity && (!hblk_key_cache.entries || !hblk_key_cache.buckets))
+	{
+		free(hblk_key_cache.entries);
+		free(hblk_key_cache.buckets);
+		hblk_key_cache.entries = NULL;
+		hblk_key_cache.buckets = NULL;
+		hblk_key_cache.capacity = 0;
+		ret = -1;
+	}
+	pthread_mutex_unlock(&hblk_key_cache.lock);
+
+	return (ret);
+}
+
+
+
+/**
+ * hblk_key_cache_clear - program that drops every key of the cache, which
+ * stays enabled
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_key_cache_clear(void)
+{
+	pthread_mutex_lock(&hblk_key_cache.lock);
+	cache_release();
+	pthread_mutex_unlock(&hblk_key_cache.lock);
+}
@@ -0,0 +1,80 @@
+#ifndef HBLK_KEY_CACHE_H
+#define HBLK_KEY_CACHE_H
+
+
+#include "hblk_crypto.h"
+#include <pthread.h>
+
+
+
+/* Suggested number of keys to cache, see hblk_key_cache_init() */
+# define HBLK_KEY_CACHE_SIZE 1024
+
+
+/**
+ * struct hblk_key_entry_s - Cached verification key
+ *
+ * @pub:   Public key, in uncompressed octet string form
+ * @key:   Reference held by the cache on the key made from @pub
+ * @chain: Next entry of the same bucket
+ * @prev:  More recently used entry, NULL for the most recent
+ * @next:  Less recently used entry, NULL for the least recent
+ */
+
+typedef struct hblk_key_entry_s
+{
+	uint8_t     pub[EC_PUB_LEN];
+	EC_KEY      *key;
+	struct hblk_key_entry_s     *chain;
+	struct hblk_key_entry_s     *prev;
+	struct hblk_key_entry_s     *next;
+} hblk_key_entry_t;
+
+
+
+/**
+ * struct hblk_key_cache_s - LRU cache of the keys made by ec_from_pub()
+ *
+ * @lock:     Protects every other member
+ * @entries:  Array of @capacity entries, allocated once
+ * @buckets:  Hash table of the cached entries, @mask + 1 buckets
+ * @mask:     Number of buckets minus 1
+ * @seed:     Random seed of the hash of the public keys
+ * @capacity: Maximum number of keys, 0 while the cache is disabled
+ * @count:    Number of cached keys
+ * @head:     Most recently used entry
+ * @tail:     Least recently used entry, evicted first
+ *
+ * Description: The cache maps a public key to a ready-to-use EC_KEY: on a
+ * hit, ec_from_pub() returns a new reference to the cached key instead of
+ * decoding the point again. Hits, misses and evictions are counted as
+ * HBLK_STAT_KEY_CACHE_* (see hblk_stats.h).
+ */
+
+typedef struct hblk_key_cache_s
+{
+	pthread_mutex_t     lock;
+	hblk_key_entry_t    *entries;
+	hblk_key_entry_t    **buckets;
+	uint32_t    mask;
+	uint64_t    seed;
+	uint32_t    capacity;
+	uint32_t    count;
+	hblk_key_entry_t    *head;
+	hblk_key_entry_t    *tail;
+} hblk_key_cache_t;
+
+
+extern hblk_key_cache_t hblk_key_cache;
+
+
+EC_GROUP const *hblk_ec_group(void);
+int hblk_key_cache_init(uint32_t capacity);
+void hblk_key_cache_clear(void);
+EC_KEY *hblk_key_cache_get(uint8_t const pub[EC_PUB_LEN]);
+void hblk_key_cache_put(uint8_t const pub[EC_PUB_LEN], EC_KEY *key);
+void hblk_key_lru_unlink(hblk_key_entry_t *entry);
+void hblk_key_lru_push(hblk_key_entry_t *entry);
+
+
+#endif /* HBLK_KEY_CACHE_H */
@@ -0,0 +1,132 @@
+#include "hblk_key_cache.h"
+
+/**
+ * cache_bucket - program that finds the bucket of a public key
+ *
+ * the x coordinate of a point being uniformly distributed, 8 of its bytes
+ * mixed with the seed of the cache make the hash
+ *
+ * @pub: the public key
+ *
+ * Return: the address of the head of the bucket of @pub
+ */
+
+static hblk_key_entry_t **cache_bucket(uint8_t const pub[EC_PUB_LEN])
+{
+	uint64_t hash;
+
+	memcpy(&hash, pub + 1, sizeof(hash));
+	hash = (hash ^ hblk_key_cache.seed) * 0x9e3779b97f4a7c15ULL;
+
+	return (&hblk_key_cache.buckets[(hash >> 32) & hblk_key_cache.mask]);
+}
+
+
+
+/**
+ * cache_entry - program that provides an entry to cache a new key in
+ *
+ * while the cache is not full, the next unused entry is taken; otherwise
+ * the least recently used key is evicted
+ *
+ * Return: a pointer to the entry, unlisted
+ */
+
+static hblk_key_entry_t *cache_entry(void)
+{
+	hblk_key_entry_t *entry, **link;
+
+	if (hblk_key_cache.count < hblk_key_cache.capacity)
+		return (&hblk_key_cache.entries[hblk_key_cache.count++]);
+
+	entry = hblk_key_cache.tail;
+	for (link = cache_bucket(entry->pub); *link != entry;)
+		link = &(*link)->chain;
+	*link = entry->chain;
+	hblk_key_lru_unlink(entry);
+	EC_KEY_free(entry->key);
+	entry->key = NULL;
+	HBLK_STAT_ADD(HBLK_STAT_KEY_CACHE_EVICT, 1);
+
+	return (entry);
+}
+
+
+
+/**
+ * hblk_key_cache_get - program that looks a public key up in the cache
+ *
+ * @pub: the public key
+ *
+ * Return: a new reference to the cached key, to release with
+ *         EC_KEY_free(), or NULL if @pub is not cached or the cache is
+ *         disabled
+ */
+
+EC_KEY *hblk_key_cache_get(uint8_t const pub[EC_PUB_LEN])
+{
+	hblk_key_entry_t *entry;
+	EC_KEY *key = NULL;
+
+	pthread_mutex_lock(&hblk_key_cache.lock);
+	if (!hblk_key_cache.capacity)
+	{
+		pthread_mutex_unlock(&hblk_key_cache.lock);
+		return (NULL);
+	}
+	for (entry = *cache_bucket(pub); entry; entry = entry->chain)
+		if (!memcmp(entry->pub, pub, EC_PUB_LEN))
+			break;
+	if (entry && EC_KEY_up_ref(entry->key))
+	{
+		key = entry->key;
+		hblk_key_lru_unlink(entry);
+		hblk_key_lru_push(entry);
+	}
+	pthread_mutex_unlock(&hblk_key_cache.lock);
+	HBLK_STAT_ADD(key ? HBLK_STAT_KEY_CACHE_HIT :
+		      HBLK_STAT_KEY_CACHE_MISS, 1);
+
+	return (key);
+}
+
+
+
+/**
+ * hblk_key_cache_put - program that caches the key made from a public key
+ *
+ * nothing is done if @pub is already cached (another thread may have made
+ * its key meanwhile) or if the cache is disabled
+ *
+ * @pub: the public key
+ * @key: the key made from @pub; the cache takes a reference of its own
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_key_cache_put(uint8_t const pub[EC_PUB_LEN], EC_KEY *key)
+{
+	hblk_key_entry_t *entry, **bucket;
+
+	pthread_mutex_lock(&hblk_key_cache.lock);
+	if (!hblk_key_cache.capacity || !key)
+	{
+		pthread_mutex_unlock(&hblk_key_cache.lock);
+		return;
+	}
+	bucket = cache_bucket(pub);
+	for (entry = *bucket; entry; entry = entry->chain)
+		if (!memcmp(entry->pub, pub, EC_PUB_LEN))
+			break;
+	if (!entry && EC_KEY_up_ref(key))
+	{
+		entry = cache_entry();
+		memcpy(entry->pub, pub, EC_PUB_LEN);
+		entry->key = key;
+		bucket = cache_bucket(pub);
+		entry->chain = *bucket;
+		*bucket = entry;
+		hblk_key_lru_push(entry);
+	}
+	pthread_mutex_unlock(&hblk_key_cache.lock);
+}
@@ -0,0 +1,144 @@
+#include "hblk_hist.h"
+#include <stdlib.h>
+
+hblk_latency_t hblk_latency = {
+	PTHREAD_MUTEX_INITIALIZER, PTHREAD_ONCE_INIT, 0, 0, NULL, {{0}}
+};
+
+static _Thread_local hblk_latency_slot_t *latency_slot;
+
+/**
+ * slot_release - program that merges the slot of an exiting thread into
+ * the retired histograms of the registry
+ *
+ * @arg: a pointer to the slot of the thread
+ *
+ * Return: nothing (void)
+ */
+
+static void slot_release(void *arg)
+{
+	hblk_latency_slot_t *slot = arg, **link;
+	unsigned int i;
+
+	pthread_mutex_lock(&hblk_latency.lock);
+	for (link = &hblk_latency.slots; *link && *link != slot;)
+		link = &(*link)->next;
+	if (*link)
+		*link = slot->next;
+	/* a slot not cleared since the last reset holds stale latencies */
+	if (atomic_load(&slot->gen) == atomic_load(&hblk_latency.gen))
+		for (i = 0; i < HBLK_LAT_MAX; i++)
+			hblk_hist_merge(&hblk_latency.retired[i],
+					&slot->hists[i]);
+	pthread_mutex_unlock(&hblk_latency.lock);
+
+	latency_slot = NULL;
+	free(slot);
+}
+
+
+
+/**
+ * latency_key_create - program that creates the key releasing the slots
+ * of exiting threads
+ *
+ * Return: nothing (void)
+ */
+
+static void latency_key_create(void)
+{
+	pthread_key_create(&hblk_latency.key, slot_release);
+}
+
+
+
+/**
+ * slot_create - program that creates and registers the slot of the
+ * calling thread
+ *
+ * Return: a pointer to the slot, or NULL on failure
+ */
+
+static hblk_latency_slot_t *slot_create(void)
+{
+	hblk_latency_slot_t *slot;
+	unsigned int i;
+
+	pthread_once(&hblk_latency.once, latency_key_create);
+	slot = aligned_alloc(64, (sizeof(*slot) + 63) & ~(size_t)63);
+	if (!slot)
+		return (NULL);
+	for (i = 0; i < HBLK_LAT_MAX; i++)
+		hblk_hist_clear(&slot->hists[i]);
+
+	pthread_mutex_lock(&hblk_latency.lock);
+	atomic_init(&slot->gen, atomic_load(&hblk_latency.gen));
+	slot->next = hblk_latency.slots;
+	hblk_latency.slots = slot;
+	pthread_mutex_unlock(&hblk_latency.lock);
+
+	pthread_setspecific(hblk_latency.key, slot);
+	latency_slot = slot;
+
+	return (slot);
+}
+
+
+
+/**
+ * hblk_hist_clear - program that empties a histogram
+ *
+ * only the thread recording in the histogram may clear it
+ *
+ * @hist: a pointer to the histogram
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_hist_clear(hblk_hist_t *hist)
+{
+	unsigned int i;
+
+	atomic_store_explicit(&hist->count, 0, memory_order_relaxed);
+	atomic_store_explicit(&hist->sum, 0, memory_order_relaxed);
+	atomic_store_explicit(&hist->min, 0, memory_order_relaxed);
+	atomic_store_explicit(&hist->max, 0, memory_order_relaxed);
+	for (i = 0; i < HBLK_HIST_BUCKETS; i++)
+		atomic_store_explicit(&hist->counts[i], 0,
+				      memory_order_relaxed);
+}
+
+
+
+/**
+ * hblk_latency_record - program that records a latency in the histogram
+ * of the calling thread
+ *
+ * the slot of the thread is first cleared if hblk_latency_reset() was
+ * called since it last recorded
+ *
+ * @id: the latency, one of HBLK_LAT_*
+ * @ns: the latency, in nanoseconds
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_latency_record(unsigned int id, uint64_t ns)
+{
+	hblk_latency_slot_t *slot = latency_slot;
+	uint64_t gen;
+	unsigned int i;
+
+	if (id >= HBLK_LAT_MAX || (!slot && !(slot = slot_create())))
+		return;
+
+	gen = atomic_load_explicit(&hblk_latency.gen, memory_order_acquire);
+	if (atomic_load_explicit(&slot->gen, memory_order_relaxed) != gen)
+	{
+		for (i = 0; i < HBLK_LAT_MAX; i++)
+			hblk_hist_clear(&slot->hists[i]);
+		atomic_store_explicit(&slot->gen, gen, memory_order_release);
+	}
+	hblk_hist_record(&slot->hists[id], ns);
+}
@@ -0,0 +1,128 @@
+#include "hblk_hist.h"
+
+/**
+ * hblk_latency_get - program that merges the histograms of a latency over
+ * every thread
+ *
+ * @id: the latency, one of HBLK_LAT_*
+ * @hist: a pointer to the histogram to fill, owned by the caller
+ *
+ * Return: 0 on success, -1 if @id is invalid
+ */
+
+int hblk_latency_get(unsigned int id, hblk_hist_t *hist)
+{
+	hblk_latency_slot_t const *slot;
+	uint64_t gen;
+
+	if (id >= HBLK_LAT_MAX || !hist)
+		return (-1);
+
+	hblk_hist_clear(hist);
+	pthread_mutex_lock(&hblk_latency.lock);
+	gen = atomic_load(&hblk_latency.gen);
+	hblk_hist_merge(hist, &hblk_latency.retired[id]);
+	for (slot = hblk_latency.slots; slot; slot = slot->next)
+		if (atomic_load_explicit(&slot->gen,
+					 memory_order_acquire) == gen)
+			hblk_hist_merge(hist, &slot->hists[id]);
+	pthread_mutex_unlock(&hblk_latency.lock);
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_latency_name - program that names a latency
+ *
+ * @id: the latency, one of HBLK_LAT_*
+ *
+ * Return: the name of the latency, or NULL if @id is invalid
+ */
+
+char const *hblk_latency_name(unsigned int id)
+{
+	static char const *const names[HBLK_LAT_MAX] = {
+		"block_valid", "block_append", "ec_sign", "ec_verify"
+	};
+
+	return (id < HBLK_LAT_MAX ? names[id] : NULL);
+}
+
+
+
+/**
+ * hblk_latency_reset - program that empties every latency histogram
+ *
+ * the histograms of the running threads are only marked stale: each
+ * thread clears its own when it next records
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_latency_reset(void)
+{
+	unsigned int i;
+
+	pthread_mutex_lock(&hblk_latency.lock);
+	for (i = 0; i < HBLK_LAT_MAX; i++)
+		hblk_hist_clear(&hblk_latency.retired[i]);
+	atomic_fetch_add_explicit(&hblk_latency.gen, 1, memory_order_release);
+	pthread_mutex_unlock(&hblk_latency.lock);
+}
+
+
+
+/**
+ * hblk_hist_print - program that prints the percentiles of a histogram
+ * as text
+ *
+ * one line: the name, the number of values, then the mean, p50, p99,
+ * p99.9 and max, in microseconds
+ *
+ * @stream: the stream to print to
+ * @name: the name to print first
+ * @hist: a pointer to the histogram, of latencies in nanoseconds
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_hist_print(FILE *stream, char const *name, hblk_hist_t const *hist)
+{
+	uint64_t count = atomic_load(&hist->count);
+
+	if (!stream)
+		return;
+
+	fprintf(stream, "%-14s %10lu mean %10.3f p50 %10.3f p99 %10.3f "
+		"p99.9 %10.3f max %10.3f us\n", name, (unsigned long)count,
+		count ? atomic_load(&hist->sum) / 1e3 / count : 0.0,
+		hblk_hist_percentile(hist, 50) / 1e3,
+		hblk_hist_percentile(hist, 99) / 1e3,
+		hblk_hist_percentile(hist, 99.9) / 1e3,
+		atomic_load(&hist->max) / 1e3);
+}
+
+
+
+/**
+ * hblk_latency_print - program that prints the percentiles of every
+ * latency as text
+ *
+ * @stream: the stream to print to
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_latency_print(FILE *stream)
+{
+	hblk_hist_t hist;
+	unsigned int i;
+
+	for (i = 0; i < HBLK_LAT_MAX; i++)
+	{
+		hblk_latency_get(i, &hist);
+		hblk_hist_print(stream, hblk_latency_name(i), &hist);
+	}
+}
@@ -0,0 +1,124 @@
+#include "hblk_sig_cache.h"
+#include <openssl/rand.h>
+
+hblk_sig_cache_t hblk_sig_cache = {
+	PTHREAD_RWLOCK_INITIALIZER, {PTHREAD_MUTEX_INITIALIZER}, NULL, 0, {0}
+};
+
+static pthread_once_t stripes_once = PTHREAD_ONCE_INIT;
+
+/**
+ * stripes_init - program that initializes the locks of the sets
+ *
+ * Return: nothing (void)
+ */
+
+static void stripes_init(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < HBLK_SIG_CACHE_STRIPES; i++)
+		pthread_mutex_init(&hblk_sig_cache.stripes[i], NULL);
+}
+
+
+
+/**
+ * hblk_sig_cache_init - program that enables, resizes or disables the
+ * cache of the signatures accepted by ec_verify()
+ *
+ * the signatures cached so far are dropped, and a new salt is drawn
+ *
+ * @size: the number of signatures to cache, rounded up to a power of 2
+ *        (HBLK_SIG_CACHE_SIZE is a sensible default), or 0 to disable the
+ *        cache
+ *
+ * Return: 0 on success, -1 on failure (the cache is then disabled)
+ */
+
+int hblk_sig_cache_init(uint32_t size)
+{
+	uint32_t nsets = 1;
+	int ret = 0;
+
+	pthread_once(&stripes_once, stripes_init);
+	while (nsets * HBLK_SIG_CACHE_WAYS < size && nsets < (1U << 28))
+		nsets <<= 1;
+
+	pthread_rwlock_wrlock(&hblk_sig_cache.resize);
+	free(hblk_sig_cache.sets);
+	hblk_sig_cache.sets = size ? calloc(nsets, sizeof(hblk_sig_set_t)) :
+		NULL;
+	hblk_sig_cache.mask = nsets - 1;
+	if (size && (!hblk_sig_cache.sets ||
+		     RAND_bytes(hblk_sig_cache.salt, HBLK_SIG_CACHE_SALT) != 1))
+	{
+		free(hblk_sig_cache.sets);
+		hblk_sig_cache.sets = NULL;
+		ret = -1;
+	}
+	pthread_rwlock_unlock(&hblk_sig_cache.resize);
+
+	return (ret);
+}
+
+
+
+/**
+ * hblk_sig_cache_clear - program that drops every signature of the cache,
+ * which stays enabled
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_sig_cache_clear(void)
+{
+	pthread_rwlock_wrlock(&hblk_sig_cache.resize);
+	if (hblk_sig_cache.sets)
+		memset(hblk_sig_cache.sets, 0, (hblk_sig_cache.mask + 1) *
+		       sizeof(hblk_sig_set_t));
+	pthread_rwlock_unlock(&hblk_sig_cache.resize);
+}
+
+
+
+/**
+ * hblk_sig_cache_id - program that computes the identifier of a
+ * verification in the cache
+ *
+ * the salted SHA-256 of the public key, the SHA-256 of the message and
+ * the signature
+ *
+ * @key: the public key of the signer
+ * @msg: the signed message
+ * @msglen: the size of @msg
+ * @sig: the signature
+ * @id: the buffer to store the identifier in
+ *
+ * Return: 0 on success, -1 if the cache is disabled or on failure
+ */
+
+int hblk_sig_cache_id(EC_KEY const *key, uint8_t const *msg, size_t msglen,
+		      sig_t const *sig, uint8_t id[SHA256_DIGEST_LENGTH])
+{
+	uint8_t buf[HBLK_SIG_CACHE_SALT + EC_PUB_LEN + SHA256_DIGEST_LENGTH +
+		    1 + SIG_MAX_LEN], *pos = buf;
+	int enabled;
+
+	pthread_rwlock_rdlock(&hblk_sig_cache.resize);
+	enabled = hblk_sig_cache.sets != NULL;
+	memcpy(pos, hblk_sig_cache.salt, HBLK_SIG_CACHE_SALT);
+	pthread_rwlock_unlock(&hblk_sig_cache.resize);
+	if (!enabled || sig->len > SIG_MAX_LEN)
+		return (-1);
+
+	pos += HBLK_SIG_CACHE_SALT;
+	if (!ec_to_pub(key, pos) ||
+	    !SHA256(msg, msglen, pos + EC_PUB_LEN))
+		return (-1);
+	pos += EC_PUB_LEN + SHA256_DIGEST_LENGTH;
+	*pos++ = sig->len;
+	memcpy(pos, sig->sig, sig->len);
+
+	return (SHA256(buf, pos + sig->len - buf, id) ? 0 : -1);
+}
@@ -0,0 +1,79 @@
+#ifndef HBLK_SIG_CACHE_H
+#define HBLK_SIG_CACHE_H
+
+
+#include "hblk_crypto.h"
+#include <pthread.h>
+
+
+
+/* Suggested number of results to cache, see hblk_sig_cache_init() */
+# define HBLK_SIG_CACHE_SIZE    65536
+
+/* Number of results per set, and of locks over the sets */
+# define HBLK_SIG_CACHE_WAYS    4
+# define HBLK_SIG_CACHE_STRIPES 64
+
+/* Size of the random salt of the identifiers */
+# define HBLK_SIG_CACHE_SALT    32
+
+
+/**
+ * struct hblk_sig_set_s - Set of verified signatures
+ *
+ * @ids:    Identifiers of the signatures, see hblk_sig_cache_id()
+ * @used:   Bit mask of the @ids in use
+ * @victim: Way replaced next once the set is full
+ */
+
+typedef struct hblk_sig_set_s
+{
+	uint8_t     ids[HBLK_SIG_CACHE_WAYS][SHA256_DIGEST_LENGTH];
+	uint8_t     used;
+	uint8_t     victim;
+} hblk_sig_set_t;
+
+
+
+/**
+ * struct hblk_sig_cache_s - Cache of the signatures ec_verify() accepted
+ *
+ * @resize:  Held for reading by lookups, for writing while the cache is
+ *           resized
+ * @stripes: Locks of the sets, set i being protected by lock
+ *           i % HBLK_SIG_CACHE_STRIPES
+ * @sets:    Array of @mask + 1 sets, NULL while the cache is disabled
+ * @mask:    Number of sets minus 1
+ * @salt:    Random salt of the identifiers, drawn on every resize
+ *
+ * Description: A set-associative table of the salted SHA-256 of (public
+ * key, message digest, signature) of the signatures found valid: looking
+ * a verification up costs two hashes and a short locked scan instead of
+ * an ECDSA verification. Only successes are cached, and a full set
+ * replaces its entries in turn, so the cache stays bounded and cannot be
+ * filled with invalid signatures. The salt keeps an attacker from
+ * crafting signatures that evict chosen entries.
+ */
+
+typedef struct hblk_sig_cache_s
+{
+	pthread_rwlock_t    resize;
+	pthread_mutex_t     stripes[HBLK_SIG_CACHE_STRIPES];
+	hblk_sig_set_t      *sets;
+	uint32_t    mask;
+	uint8_t     salt[HBLK_SIG_CACHE_SALT];
+} hblk_sig_cache_t;
+
+
+extern hblk_sig_cache_t hblk_sig_cache;
+
+
+int hblk_sig_cache_init(uint32_t size);
+void hblk_sig_cache_clear(void);
+int hblk_sig_cache_id(EC_KEY const *key, uint8_t const *msg, size_t msglen,
+		      sig_t const *sig, uint8_t id[SHA256_DIGEST_LENGTH]);
+int hblk_sig_cache_find(uint8_t const id[SHA256_DIGEST_LENGTH]);
+void hblk_sig_cache_add(uint8_t const id[SHA256_DIGEST_LENGTH]);
+
+
+#endif /* HBLK_SIG_CACHE_H */
@@ -0,0 +1,102 @@
+#include "hblk_sig_cache.h"
+
+/**
+ * cache_set - program that locks the set of an identifier
+ *
+ * the resize lock of the cache must be held, and the cache enabled
+ *
+ * @id: the identifier, whose first bytes are uniformly distributed
+ * @stripe: the address at which to store the lock taken, to release
+ *
+ * Return: a pointer to the set of @id
+ */
+
+static hblk_sig_set_t *cache_set(uint8_t const id[SHA256_DIGEST_LENGTH],
+				 pthread_mutex_t **stripe)
+{
+	uint32_t index;
+
+	memcpy(&index, id, sizeof(index));
+	index &= hblk_sig_cache.mask;
+	*stripe = &hblk_sig_cache.stripes[index % HBLK_SIG_CACHE_STRIPES];
+	pthread_mutex_lock(*stripe);
+
+	return (&hblk_sig_cache.sets[index]);
+}
+
+
+
+/**
+ * hblk_sig_cache_find - program that looks a verification up in the cache
+ *
+ * @id: the identifier of the verification, see hblk_sig_cache_id()
+ *
+ * Return: 1 if the signature was found valid before, 0 otherwise
+ */
+
+int hblk_sig_cache_find(uint8_t const id[SHA256_DIGEST_LENGTH])
+{
+	pthread_mutex_t *stripe;
+	hblk_sig_set_t *set;
+	unsigned int way;
+	int found = 0;
+
+	pthread_rwlock_rdlock(&hblk_sig_cache.resize);
+	if (hblk_sig_cache.sets)
+	{
+		set = cache_set(id, &stripe);
+		for (way = 0; !found && way < HBLK_SIG_CACHE_WAYS; way++)
+			found = (set->used >> way & 1) &&
+				!memcmp(set->ids[way], id,
+					SHA256_DIGEST_LENGTH);
+		pthread_mutex_unlock(stripe);
+	}
+	pthread_rwlock_unlock(&hblk_sig_cache.resize);
+	HBLK_STAT_ADD(found ? HBLK_STAT_SIG_CACHE_HIT :
+		      HBLK_STAT_SIG_CACHE_MISS, 1);
+
+	return (found);
+}
+
+
+
+/**
+ * hblk_sig_cache_add - program that records a valid signature in the
+ * cache
+ *
+ * a free way of the set is taken; once the set is full, its ways are
+ * replaced in turn
+ *
+ * @id: the identifier of the verification, see hblk_sig_cache_id()
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_sig_cache_add(uint8_t const id[SHA256_DIGEST_LENGTH])
+{
+	pthread_mutex_t *stripe;
+	hblk_sig_set_t *set;
+	unsigned int way;
+
+	pthread_rwlock_rdlock(&hblk_sig_cache.resize);
+	if (hblk_sig_cache.sets)
+	{
+		set = cache_set(id, &stripe);
+		for (way = 0; way < HBLK_SIG_CACHE_WAYS; way++)
+			if ((set->used >> way & 1) &&
+			    !memcmp(set->ids[way], id, SHA256_DIGEST_LENGTH))
+				break;
+		if (way == HBLK_SIG_CACHE_WAYS)
+		{
+			for (way = 0; way < HBLK_SIG_CACHE_WAYS &&
+			     set->used >> way & 1; way++)
+				;
+			if (way == HBLK_SIG_CACHE_WAYS)
+				way = set->victim++ % HBLK_SIG_CACHE_WAYS;
+			memcpy(set->ids[way], id, SHA256_DIGEST_LENGTH);
+			set->used |= 1 << way;
+		}
+		pthread_mutex_unlock(stripe);
+	}
+	pthread_rwlock_unlock(&hblk_sig_cache.resize);
+}
@@ -0,0 +1,132 @@
+#include "hblk_stats.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Size of a slot, a whole number of cache lines */
+#define SLOT_SIZE ((sizeof(hblk_stats_slot_t) + 63) & ~(size_t)63)
+
+hblk_stats_t hblk_stats = {
+	PTHREAD_MUTEX_INITIALIZER, PTHREAD_ONCE_INIT, 0, NULL, {0}, {0}
+};
+
+static _Thread_local hblk_stats_slot_t *stats_slot;
+
+/**
+ * slot_release - program that folds the slot of an exiting thread into
+ * the retired counts of the registry
+ *
+ * @arg: a pointer to the slot of the thread
+ *
+ * Return: nothing (void)
+ */
+
+static void slot_release(void *arg)
+{
+	hblk_stats_slot_t *slot = arg, **link;
+	unsigned int i;
+
+	pthread_mutex_lock(&hblk_stats.lock);
+	for (link = &hblk_stats.slots; *link && *link != slot;)
+		link = &(*link)->next;
+	if (*link)
+		*link = slot->next;
+	for (i = 0; i < HBLK_STAT_MAX; i++)
+		hblk_stats.retired[i] +=
+			atomic_load_explicit(&slot->values[i],
+					     memory_order_relaxed);
+	pthread_mutex_unlock(&hblk_stats.lock);
+
+	stats_slot = NULL;
+	free(slot);
+}
+
+
+
+/**
+ * stats_key_create - program that creates the key releasing the slots of
+ * exiting threads
+ *
+ * Return: nothing (void)
+ */
+
+static void stats_key_create(void)
+{
+	pthread_key_create(&hblk_stats.key, slot_release);
+}
+
+
+
+/**
+ * slot_create - program that creates and registers the slot of the
+ * calling thread
+ *
+ * Return: a pointer to the slot, or NULL on failure
+ */
+
+static hblk_stats_slot_t *slot_create(void)
+{
+	hblk_stats_slot_t *slot;
+	unsigned int i;
+
+	pthread_once(&hblk_stats.once, stats_key_create);
+	slot = aligned_alloc(64, SLOT_SIZE);
+	if (!slot)
+		return (NULL);
+	for (i = 0; i < HBLK_STAT_MAX; i++)
+		atomic_init(&slot->values[i], 0);
+
+	pthread_mutex_lock(&hblk_stats.lock);
+	slot->next = hblk_stats.slots;
+	hblk_stats.slots = slot;
+	pthread_mutex_unlock(&hblk_stats.lock);
+
+	pthread_setspecific(hblk_stats.key, slot);
+	stats_slot = slot;
+
+	return (slot);
+}
+
+
+
+/**
+ * hblk_stat_add - program that adds to a counter of the calling thread
+ *
+ * the thread being the only writer of its slot, a relaxed load and store
+ * are enough: no lock, no read-modify-write instruction
+ *
+ * @id: the counter, one of HBLK_STAT_*
+ * @n: the amount to add
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_stat_add(unsigned int id, uint64_t n)
+{
+	hblk_stats_slot_t *slot = stats_slot;
+
+	if (id >= HBLK_STAT_MAX || (!slot && !(slot = slot_create())))
+		return;
+
+	atomic_store_explicit(&slot->values[id],
+			      atomic_load_explicit(&slot->values[id],
+						   memory_order_relaxed) + n,
+			      memory_order_relaxed);
+}
+
+
+
+/**
+ * hblk_stat_now - program that reads the monotonic clock for timers
+ *
+ * Return: the current time, in nanoseconds
+ */
+
+uint64_t hblk_stat_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return ((uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec);
+}
@@ -0,0 +1,102 @@
+#ifndef HBLK_STATS_H
+#define HBLK_STATS_H
+
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+
+
+/* Counters and timers (nanoseconds, suffixed _NS) of the hot paths */
+# define HBLK_STAT_SHA256           0
+# define HBLK_STAT_SHA256_BYTES     1
+# define HBLK_STAT_EC_SIGN          2
+# define HBLK_STAT_EC_SIGN_NS       3
+# define HBLK_STAT_EC_VERIFY        4
+# define HBLK_STAT_EC_VERIFY_NS     5
+# define HBLK_STAT_BLOCK_HASH       6
+# define HBLK_STAT_BLOCK_HASH_BYTES 7
+# define HBLK_STAT_BLOCK_ALLOC      8
+# define HBLK_STAT_WRITE_BLOCKS     9
+# define HBLK_STAT_WRITE_BYTES      10
+# define HBLK_STAT_WRITE_NS         11
+# define HBLK_STAT_KEY_CACHE_HIT    12
+# define HBLK_STAT_KEY_CACHE_MISS   13
+# define HBLK_STAT_KEY_CACHE_EVICT  14
+# define HBLK_STAT_SIG_CACHE_HIT    15
+# define HBLK_STAT_SIG_CACHE_MISS   16
+# define HBLK_STAT_MAX              17
+
+/*
+ * Compiling with -DHBLK_NO_STATS removes every counter update and clock
+ * read from the hot paths; the query functions then report zeros
+ */
+# ifndef HBLK_NO_STATS
+#  define HBLK_STAT_ADD(id, n) hblk_stat_add((id), (n))
+#  define HBLK_STAT_NOW() hblk_stat_now()
+#  define HBLK_STAT_ELAPSED(id, start) \
+	hblk_stat_add((id), hblk_stat_now() - (start))
+# else
+#  define HBLK_STAT_ADD(id, n) ((void)(n))
+#  define HBLK_STAT_NOW() ((uint64_t)0)
+#  define HBLK_STAT_ELAPSED(id, start) ((void)(start))
+# endif
+
+
+/**
+ * struct hblk_stats_slot_s - Counters of a single thread
+ *
+ * @values: Value of every counter; only the owning thread writes them
+ * @next:   Next slot of the registry
+ */
+
+typedef struct hblk_stats_slot_s
+{
+	_Atomic uint64_t        values[HBLK_STAT_MAX];
+	struct hblk_stats_slot_s    *next;
+} hblk_stats_slot_t;
+
+
+
+/**
+ * struct hblk_stats_s - Registry of the counters of every thread
+ *
+ * @lock:     Protects @slots, @retired and @baseline
+ * @once:     Creates @key on first use
+ * @key:      Releases the slot of a thread when it exits
+ * @slots:    Slots of the running threads
+ * @retired:  Counts of the threads that exited
+ * @baseline: Totals at the last hblk_stats_reset()
+ *
+ * Description: Every thread counts in its own slot, created on its first
+ * update, with relaxed atomic loads and stores: no two threads ever write
+ * the same cache line, and no update takes a lock or a locked
+ * instruction. Readers sum the slots under @lock; a thread exiting folds
+ * its slot into @retired.
+ */
+
+typedef struct hblk_stats_s
+{
+	pthread_mutex_t     lock;
+	pthread_once_t      once;
+	pthread_key_t       key;
+	hblk_stats_slot_t   *slots;
+	uint64_t    retired[HBLK_STAT_MAX];
+	uint64_t    baseline[HBLK_STAT_MAX];
+} hblk_stats_t;
+
+
+extern hblk_stats_t hblk_stats;
+
+
+void hblk_stat_add(unsigned int id, uint64_t n);
+uint64_t hblk_stat_now(void);
+uint64_t hblk_stat_get(unsigned int id);
+char const *hblk_stat_name(unsigned int id);
+void hblk_stats_reset(void);
+void hblk_stats_print(FILE *stream);
+
+
+#endif /* HBLK_STATS_H */
@@ -0,0 +1,127 @@
+#include "hblk_stats.h"
+#include <string.h>
+
+/**
+ * stats_total - program that sums a counter over every thread
+ *
+ * the lock of the registry must be held
+ *
+ * @id: the counter, one of HBLK_STAT_*
+ *
+ * Return: the sum of the counter since the program started
+ */
+
+static uint64_t stats_total(unsigned int id)
+{
+	hblk_stats_slot_t const *slot;
+	uint64_t total = hblk_stats.retired[id];
+
+	for (slot = hblk_stats.slots; slot; slot = slot->next)
+		total += atomic_load_explicit(&slot->values[id],
+					      memory_order_relaxed);
+
+	return (total);
+}
+
+
+
+/**
+ * hblk_stat_get - program that reads a counter, summed over every thread
+ *
+ * @id: the counter, one of HBLK_STAT_*
+ *
+ * Return: the value of the counter since the last hblk_stats_reset(), 0
+ *         if @id is invalid
+ */
+
+uint64_t hblk_stat_get(unsigned int id)
+{
+	uint64_t value;
+
+	if (id >= HBLK_STAT_MAX)
+		return (0);
+
+	pthread_mutex_lock(&hblk_stats.lock);
+	value = stats_total(id) - hblk_stats.baseline[id];
+	pthread_mutex_unlock(&hblk_stats.lock);
+
+	return (value);
+}
+
+
+
+/**
+ * hblk_stat_name - program that names a counter
+ *
+ * @id: the counter, one of HBLK_STAT_*
+ *
+ * Return: the name of the counter, or NULL if @id is invalid
+ */
+
+char const *hblk_stat_name(unsigned int id)
+{
+	static char const *const names[HBLK_STAT_MAX] = {
+		"sha256", "sha256_bytes", "ec_sign", "ec_sign_ns",
+		"ec_verify", "ec_verify_ns", "block_hash", "block_hash_bytes",
+		"block_alloc", "write_blocks", "write_bytes", "write_ns",
+		"key_cache_hit", "key_cache_miss", "key_cache_evict",
+		"sig_cache_hit", "sig_cache_miss"
+	};
+
+	return (id < HBLK_STAT_MAX ? names[id] : NULL);
+}
+
+
+
+/**
+ * hblk_stats_reset - program that resets every counter
+ *
+ * the current totals become the baseline subtracted by readers, so the
+ * threads counting concurrently are never written to
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_stats_reset(void)
+{
+	unsigned int i;
+
+	pthread_mutex_lock(&hblk_stats.lock);
+	for (i = 0; i < HBLK_STAT_MAX; i++)
+		hblk_stats.baseline[i] = stats_total(i);
+	pthread_mutex_unlock(&hblk_stats.lock);
+}
+
+
+
+/**
+ * hblk_stats_print - program that prints every counter as text
+ *
+ * one "name value" line per counter, from a consistent snapshot; timers
+ * are also printed in milliseconds
+ *
+ * @stream: the stream to print to
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_stats_print(FILE *stream)
+{
+	uint64_t values[HBLK_STAT_MAX];
+	unsigned int i;
+	char const *name;
+
+	pthread_mutex_lock(&hblk_stats.lock);
+	for (i = 0; i < HBLK_STAT_MAX; i++)
+		values[i] = stats_total(i) - hblk_stats.baseline[i];
+	pthread_mutex_unlock(&hblk_stats.lock);
+
+	for (i = 0; stream && i < HBLK_STAT_MAX; i++)
+	{
+		name = hblk_stat_name(i);
+		fprintf(stream, "%-18s %20lu", name, (unsigned long)values[i]);
+		if (strlen(name) > 3 && !strcmp(name + strlen(name) - 3, "_ns"))
+			fprintf(stream, " (%.3f ms)", values[i] / 1e6);
+		fprintf(stream, "\n");
+	}
+}
@@ -0,0 +1,138 @@
+#include "hblk_trace.h"
+#include "hblk_stats.h"
+#include <stdlib.h>
+
+hblk_trace_t hblk_trace = {
+	PTHREAD_MUTEX_INITIALIZER, PTHREAD_ONCE_INIT, 0, 0, HBLK_TRACE_RING,
+	0, 0, NULL
+};
+
+static _Thread_local hblk_trace_ring_t *trace_ring;
+
+/**
+ * ring_exit - program that marks the ring of an exiting thread, so that
+ * hblk_trace_stop() frees it once its spans are written out
+ *
+ * @arg: a pointer to the ring of the thread
+ *
+ * Return: nothing (void)
+ */
+
+static void ring_exit(void *arg)
+{
+	hblk_trace_ring_t *ring = arg;
+
+	atomic_store(&ring->exited, 1);
+	trace_ring = NULL;
+}
+
+
+
+/**
+ * trace_key_create - program that creates the key marking the rings of
+ * exiting threads
+ *
+ * Return: nothing (void)
+ */
+
+static void trace_key_create(void)
+{
+	pthread_key_create(&hblk_trace.key, ring_exit);
+}
+
+
+
+/**
+ * ring_create - program that creates and registers the ring of the
+ * calling thread
+ *
+ * Return: a pointer to the ring, or NULL on failure
+ */
+
+static hblk_trace_ring_t *ring_create(void)
+{
+	hblk_trace_ring_t *ring = calloc(1, sizeof(*ring));
+
+	pthread_once(&hblk_trace.once, trace_key_create);
+	if (!ring)
+		return (NULL);
+
+	pthread_mutex_lock(&hblk_trace.lock);
+	ring->events = malloc(hblk_trace.capacity * sizeof(*ring->events));
+	ring->mask = hblk_trace.capacity - 1;
+	if (ring->events)
+	{
+		ring->tid = ++hblk_trace.ntids;
+		ring->next = hblk_trace.rings;
+		hblk_trace.rings = ring;
+	}
+	pthread_mutex_unlock(&hblk_trace.lock);
+	if (!ring->events)
+	{
+		free(ring);
+		return (NULL);
+	}
+
+	pthread_setspecific(hblk_trace.key, ring);
+	trace_ring = ring;
+
+	return (ring);
+}
+
+
+
+/**
+ * hblk_trace_now - program that opens a span
+ *
+ * HBLK_TRACE_BEGIN() expands to this call
+ *
+ * Return: the current time, in nanoseconds, or 0 if tracing is stopped
+ */
+
+uint64_t hblk_trace_now(void)
+{
+	if (!atomic_load_explicit(&hblk_trace.enabled, memory_order_relaxed))
+		return (0);
+
+	return (hblk_stat_now());
+}
+
+
+
+/**
+ * hblk_trace_span - program that records a span in the ring of the
+ * calling thread
+ *
+ * the span is written, then published with a release store of the head
+ * of the ring: no lock is taken once the ring of the thread exists;
+ * a release fence orders the previous store of the head before the slot
+ * is overwritten, so a reader seeing the new span also sees that head
+ *
+ * @name: the name of the span, a string literal
+ * @start: the value returned by hblk_trace_now() when the span opened;
+ *         nothing is recorded if it is 0
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_trace_span(char const *name, uint64_t start)
+{
+	hblk_trace_ring_t *ring = trace_ring;
+	hblk_trace_event_t *event;
+	uint64_t now, head;
+
+	if (!start)
+		return;
+
+	now = hblk_stat_now();
+	if (!ring && !(ring = ring_create()))
+		return;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	event = &ring->events[head & ring->mask];
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&event->name, name, memory_order_relaxed);
+	atomic_store_explicit(&event->start, start, memory_order_relaxed);
+	atomic_store_explicit(&event->dur, now - start, memory_order_relaxed);
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
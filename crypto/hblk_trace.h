@@ -0,0 +1,117 @@
+#ifndef HBLK_TRACE_H
+#define HBLK_TRACE_H
+
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+
+
+/* Default number of spans kept per thread (must be a power of 2) */
+# define HBLK_TRACE_RING 65536
+
+/*
+ * Compiling with -DHBLK_NO_TRACE removes every span from the hot paths;
+ * otherwise, a span costs an atomic load unless tracing was started with
+ * hblk_trace_start()
+ */
+# ifndef HBLK_NO_TRACE
+#  define HBLK_TRACE_BEGIN() hblk_trace_now()
+#  define HBLK_TRACE_END(name, start) hblk_trace_span((name), (start))
+# else
+#  define HBLK_TRACE_BEGIN() ((uint64_t)0)
+#  define HBLK_TRACE_END(name, start) ((void)(start))
+# endif
+
+
+/**
+ * struct hblk_trace_event_s - Span recorded by a thread
+ *
+ * @name:  Name of the span, a string literal
+ * @start: Start of the span, in nanoseconds (monotonic clock)
+ * @dur:   Duration of the span, in nanoseconds
+ *
+ * Description: The reader may load a span while its slot is overwritten,
+ * so every field is only accessed with relaxed atomic operations.
+ */
+
+typedef struct hblk_trace_event_s
+{
+	_Atomic(char const *)   name;
+	_Atomic uint64_t    start;
+	_Atomic uint64_t    dur;
+} hblk_trace_event_t;
+
+
+
+/**
+ * struct hblk_trace_ring_s - Ring buffer of the spans of a thread
+ *
+ * @events: Array of @mask + 1 spans
+ * @mask:   Number of spans of @events minus 1
+ * @head:   Number of spans ever recorded, written by the owning thread
+ * @tail:   Number of spans ever written out, written by the reader
+ * @tid:    Track of the thread in the trace
+ * @exited: Set once the thread exited
+ * @next:   Next ring of the registry
+ *
+ * Description: A single-producer, single-consumer ring: the owning thread
+ * writes a span, then publishes it by storing @head with release order;
+ * hblk_trace_stop() reads the spans between @tail and @head. When the
+ * thread outpaces the reader, the oldest spans are overwritten and only
+ * the latest @mask are written out: as in a seqlock, the reader loads a
+ * span, then re-reads @head after an acquire fence, and drops the span if
+ * its slot may have been reused meanwhile.
+ */
+
+typedef struct hblk_trace_ring_s
+{
+	hblk_trace_event_t  *events;
+	uint32_t    mask;
+	_Atomic uint64_t    head;
+	uint64_t    tail;
+	uint32_t    tid;
+	atomic_int  exited;
+	struct hblk_trace_ring_s    *next;
+} hblk_trace_ring_t;
+
+
+
+/**
+ * struct hblk_trace_s - Registry of the rings of every thread
+ *
+ * @lock:     Protects @rings and @ntids
+ * @once:     Creates @key on first use
+ * @key:      Marks the ring of a thread as exited when it exits
+ * @enabled:  Nonzero while tracing
+ * @capacity: Number of spans per ring created
+ * @ntids:    Number of rings ever created, to number the tracks
+ * @epoch:    Time tracing started, in nanoseconds
+ * @rings:    Rings of the threads that recorded a span
+ */
+
+typedef struct hblk_trace_s
+{
+	pthread_mutex_t     lock;
+	pthread_once_t      once;
+	pthread_key_t       key;
+	atomic_int  enabled;
+	uint32_t    capacity;
+	uint32_t    ntids;
+	uint64_t    epoch;
+	hblk_trace_ring_t   *rings;
+} hblk_trace_t;
+
+
+extern hblk_trace_t hblk_trace;
+
+
+uint64_t hblk_trace_now(void);
+void hblk_trace_span(char const *name, uint64_t start);
+int hblk_trace_start(uint32_t capacity);
+int hblk_trace_stop(char const *path);
+
+
+#endif /* HBLK_TRACE_H */
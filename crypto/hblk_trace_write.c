@@ -0,0 +1,149 @@
+#include "hblk_trace.h"
+#include "hblk_stats.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * write_ring - program that writes the pending spans of a ring as Chrome
+ * trace events
+ *
+ * the track of the thread is named first; the slot the thread may be
+ * writing is skipped, so a span overwritten while it was read is dropped:
+ * its fields are loaded first, and the head is only re-read after an
+ * acquire fence, so it reflects any overwrite the loads may have seen
+ *
+ * @file: the stream to write to, or NULL to only discard the spans
+ * @ring: a pointer to the ring
+ * @sep: the address of the separator to write before the next event,
+ *       updated
+ *
+ * Return: the number of spans written
+ */
+
+static uint32_t write_ring(FILE *file, hblk_trace_ring_t *ring,
+			   char const **sep)
+{
+	uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+	uint64_t pos = head - ring->tail > ring->mask ? head - ring->mask :
+		ring->tail;
+	hblk_trace_event_t const *event;
+	char const *name;
+	uint64_t start, dur;
+	uint32_t count = 0;
+
+	if (file && pos < head)
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\","
+			"\"pid\":%d,\"tid\":%u,"
+			"\"args\":{\"name\":\"thread %u\"}}",
+			*sep, (int)getpid(), ring->tid, ring->tid);
+	for (; file && pos < head; pos++)
+	{
+		event = &ring->events[pos & ring->mask];
+		name = atomic_load_explicit(&event->name, memory_order_relaxed);
+		start = atomic_load_explicit(&event->start,
+					     memory_order_relaxed);
+		dur = atomic_load_explicit(&event->dur, memory_order_relaxed);
+		atomic_thread_fence(memory_order_acquire);
+		if (atomic_load_explicit(&ring->head, memory_order_relaxed) -
+		    pos > ring->mask)
+			continue;
+		fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"hblk\","
+			"\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u}",
+			name, ((double)start - (double)hblk_trace.epoch) / 1e3,
+			dur / 1e3, (int)getpid(), ring->tid);
+		count++;
+	}
+	if (file && head > ring->tail)
+		*sep = ",\n";
+	ring->tail = head;
+
+	return (count);
+}
+
+
+
+/**
+ * hblk_trace_start - program that starts recording spans
+ *
+ * spans recorded before are discarded; the rings of the threads that
+ * record their first span from now on hold @capacity spans
+ *
+ * @capacity: the number of spans kept per thread, a power of 2, or 0 for
+ *            HBLK_TRACE_RING
+ *
+ * Return: 0 on success, -1 if @capacity is not a power of 2
+ */
+
+int hblk_trace_start(uint32_t capacity)
+{
+	hblk_trace_ring_t *ring;
+
+	if (!capacity)
+		capacity = HBLK_TRACE_RING;
+	if (capacity & (capacity - 1))
+		return (-1);
+
+	pthread_mutex_lock(&hblk_trace.lock);
+	hblk_trace.capacity = capacity;
+	hblk_trace.epoch = hblk_stat_now();
+	for (ring = hblk_trace.rings; ring; ring = ring->next)
+		write_ring(NULL, ring, NULL);
+	pthread_mutex_unlock(&hblk_trace.lock);
+	atomic_store(&hblk_trace.enabled, 1);
+
+	return (0);
+}
+
+
+
+/**
+ * hblk_trace_stop - program that stops recording spans and writes them
+ * to a Chrome trace-event JSON file
+ *
+ * every thread has its own track; the file loads in chrome://tracing and
+ * in Perfetto; the rings of the threads that exited are then freed
+ *
+ * @path: the path to the file to write, or NULL to discard the spans
+ *
+ * Return: the number of spans written, or -1 on failure
+ */
+
+int hblk_trace_stop(char const *path)
+{
+	hblk_trace_ring_t *ring, **link;
+	char const *sep = "";
+	FILE *file = NULL;
+	int count = 0;
+
+	atomic_store(&hblk_trace.enabled, 0);
+	if (path)
+	{
+		file = fopen(path, "w");
+		if (!file)
+			return (-1);
+		fprintf(file, "{\"traceEvents\":[\n");
+	}
+
+	pthread_mutex_lock(&hblk_trace.lock);
+	for (link = &hblk_trace.rings; (ring = *link) != NULL;)
+	{
+		count += write_ring(file, ring, &sep);
+		if (!atomic_load(&ring->exited))
+		{
+			link = &ring->next;
+			continue;
+		}
+		*link = ring->next;
+		free(ring->events);
+		free(ring);
+	}
+	pthread_mutex_unlock(&hblk_trace.lock);
+
+	if (file)
+	{
+		fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+		count = ferror(file) | fclose(file) ? -1 : count;
+	}
+
+	return (count);
+}
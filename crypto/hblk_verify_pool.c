@@ -0,0 +1,166 @@
+#include "hblk_verify_pool.h"
+#include <unistd.h>
+
+hblk_verify_pool_t hblk_verify_pool = {
+	PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+	PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+	NULL, 0, 0, 0, 0, 0, 0, NULL, NULL, 0, 0, 0
+};
+
+/**
+ * pool_worker - program that runs a worker thread of the pool
+ *
+ * @arg: unused
+ *
+ * Return: NULL
+ */
+
+static void *pool_worker(void *arg)
+{
+	hblk_verify_pool_t *pool = &hblk_verify_pool;
+	uint64_t gen;
+
+	(void)arg;
+	pthread_mutex_lock(&pool->lock);
+	gen = pool->spawned;
+	for (;;)
+	{
+		while (!pool->stop && pool->gen == gen)
+			pthread_cond_wait(&pool->work, &pool->lock);
+		if (pool->stop)
+			break;
+		gen = pool->gen;
+		pthread_mutex_unlock(&pool->lock);
+
+		hblk_verify_pool_work();
+
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->active == 0)
+			pthread_cond_signal(&pool->done);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	return (NULL);
+}
+
+
+
+/**
+ * pool_stop - program that stops and joins the workers of the pool
+ *
+ * the batch lock of the pool must be held
+ *
+ * @count: the number of workers that were started
+ *
+ * Return: nothing (void)
+ */
+
+static void pool_stop(uint32_t count)
+{
+	hblk_verify_pool_t *pool = &hblk_verify_pool;
+	uint32_t i;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->work);
+	pthread_mutex_unlock(&pool->lock);
+	for (i = 0; i < count; i++)
+		pthread_join(pool->threads[i], NULL);
+
+	free(pool->threads);
+	pool->threads = NULL;
+	pool->nthreads = 0;
+	pool->stop = 0;
+}
+
+
+
+/**
+ * hblk_verify_pool_start - program that (re)starts the pool with a number
+ * of threads
+ *
+ * the batch lock of the pool must be held
+ *
+ * @nthreads: the number of threads verifying a batch, the caller
+ *            included, or 0 for one per online CPU
+ *
+ * Return: the number of threads verifying a batch, or -1 on failure (the
+ *         batches are then verified on the calling thread)
+ */
+
+int hblk_verify_pool_start(uint32_t nthreads)
+{
+	hblk_verify_pool_t *pool = &hblk_verify_pool;
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+	uint32_t i;
+
+	pool_stop(pool->nthreads);
+	pool->started = 1;
+	if (!nthreads)
+		nthreads = online > 0 ? online : 1;
+	if (nthreads == 1)
+		return (1);
+
+	pool->threads = calloc(nthreads - 1, sizeof(*pool->threads));
+	if (!pool->threads)
+		return (-1);
+	pthread_mutex_lock(&pool->lock);
+	pool->spawned = pool->gen;
+	pthread_mutex_unlock(&pool->lock);
+	for (i = 0; i < nthreads - 1; i++)
+		if (pthread_create(&pool->threads[i], NULL, pool_worker, NULL))
+			break;
+	pool->nthreads = i;
+	if (i < nthreads - 1)
+	{
+		pool_stop(i);
+		return (-1);
+	}
+
+	return (nthreads);
+}
+
+
+
+/**
+ * hblk_verify_pool_init - program that sets the number of threads of
+ * ec_verify_batch()
+ *
+ * without this call, the pool starts on the first batch with one thread
+ * per online CPU
+ *
+ * @nthreads: the number of threads verifying a batch, the caller
+ *            included, or 0 for one per online CPU
+ *
+ * Return: the number of threads verifying a batch, or -1 on failure
+ */
+
+int hblk_verify_pool_init(uint32_t nthreads)
+{
+	int ret;
+
+	pthread_mutex_lock(&hblk_verify_pool.batch);
+	ret = hblk_verify_pool_start(nthreads);
+	pthread_mutex_unlock(&hblk_verify_pool.batch);
+
+	return (ret);
+}
+
+
+
+/**
+ * hblk_verify_pool_destroy - program that stops the worker threads of
+ * ec_verify_batch()
+ *
+ * a later batch starts the pool again
+ *
+ * Return: nothing (void)
+ */
+
+void hblk_verify_pool_destroy(void)
+{
+	pthread_mutex_lock(&hblk_verify_pool.batch);
+	pool_stop(hblk_verify_pool.nthreads);
+	hblk_verify_pool.started = 0;
+	pthread_mutex_unlock(&hblk_verify_pool.batch);
+}
@@ -0,0 +1,72 @@
+#ifndef HBLK_VERIFY_POOL_H
+#define HBLK_VERIFY_POOL_H
+
+
+#include "hblk_crypto.h"
+#include <stdatomic.h>
+#include <pthread.h>
+
+
+
+/* Batches smaller than this are verified on the calling thread alone */
+# define HBLK_VERIFY_MIN_BATCH 2
+
+
+/**
+ * struct hblk_verify_pool_s - Worker threads of ec_verify_batch()
+ *
+ * @batch:    Held for the whole of a batch, and while the pool is
+ *            started or stopped
+ * @lock:     Protects @gen, @stop, @active and the batch posted
+ * @work:     Signaled when a batch is posted, or the workers must stop
+ * @done:     Signaled when the last worker is done with a batch
+ * @threads:  Worker threads, @nthreads of them
+ * @nthreads: Number of worker threads, the caller of a batch working too
+ * @started:  Nonzero once the pool was started
+ * @stop:     Set to make the workers exit
+ * @gen:      Number of batches posted
+ * @spawned:  Value of @gen when the workers were started, so that a worker
+ *            running late still takes part in the first batch
+ * @active:   Number of workers not done with the current batch
+ * @items:    Signatures of the current batch
+ * @results:  Results of the current batch
+ * @count:    Number of @items
+ * @next:     Index of the next item to verify
+ * @valid:    Number of valid signatures of the current batch
+ *
+ * Description: A batch is posted to every worker at once; the workers and
+ * the caller then claim items one at a time with an atomic increment of
+ * @next, so a slow verification never holds others back.
+ */
+
+typedef struct hblk_verify_pool_s
+{
+	pthread_mutex_t     batch;
+	pthread_mutex_t     lock;
+	pthread_cond_t      work;
+	pthread_cond_t      done;
+	pthread_t   *threads;
+	uint32_t    nthreads;
+	int         started;
+	int         stop;
+	uint64_t    gen;
+	uint64_t    spawned;
+	uint32_t    active;
+	ec_verify_item_t const  *items;
+	int         *results;
+	size_t      count;
+	atomic_size_t   next;
+	atomic_size_t   valid;
+} hblk_verify_pool_t;
+
+
+extern hblk_verify_pool_t hblk_verify_pool;
+
+
+int hblk_verify_pool_start(uint32_t nthreads);
+int hblk_verify_pool_init(uint32_t nthreads);
+void hblk_verify_pool_destroy(void);
+void hblk_verify_pool_work(void);
+
+
+#endif /* HBLK_VERIFY_POOL_H */
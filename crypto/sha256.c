@@ -20,6 +20,9 @@ uint8_t *sha256(const int8_t *s, size_t len,
 	}
 
 
+	HBLK_STAT_ADD(HBLK_STAT_SHA256, 1);
+	HBLK_STAT_ADD(HBLK_STAT_SHA256_BYTES, len);
+
 	if (SHA256((const unsigned char *)s, len, digest))
 	{
 		return (digest);
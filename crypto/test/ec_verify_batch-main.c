@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "hblk_crypto.h"
+#include "hblk_verify_pool.h"
+
+#define NB_KEYS		8
+#define NB_ITEMS	64
+
+static ec_verify_item_t items[NB_ITEMS];
+
+/**
+ * _batch - Verifies the batch from another thread
+ *
+ * @arg: Array of NB_ITEMS results
+ *
+ * Return: NULL
+ */
+static void *_batch(void *arg)
+{
+	ec_verify_batch(items, NB_ITEMS, arg);
+
+	return (NULL);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	static sig_t sigs[NB_ITEMS];
+	static uint8_t msgs[NB_ITEMS][SHA256_DIGEST_LENGTH];
+	static int results[NB_ITEMS], other[NB_ITEMS];
+	uint32_t threads[] = {1, 2, 4, 0};
+	EC_KEY *keys[NB_KEYS];
+	pthread_t thread;
+	int i, j, same;
+
+	for (i = 0; i < NB_KEYS; i++)
+		keys[i] = ec_create();
+	for (i = 0; i < NB_ITEMS; i++)
+	{
+		sha256((int8_t const *)&i, sizeof(i), msgs[i]);
+		ec_sign(keys[i % NB_KEYS], msgs[i], SHA256_DIGEST_LENGTH,
+			&sigs[i]);
+		items[i].key = keys[i % NB_KEYS];
+		items[i].msg = msgs[i];
+		items[i].msglen = SHA256_DIGEST_LENGTH;
+		items[i].sig = &sigs[i];
+	}
+	/* Every 10th signature is checked against the wrong key */
+	for (i = 0; i < NB_ITEMS; i += 10)
+		items[i].key = keys[(i + 1) % NB_KEYS];
+
+	for (i = 0; i < 4; i++)
+	{
+		memset(results, 0xff, sizeof(results));
+		printf("Threads: %d, ", hblk_verify_pool_init(threads[i]) > 0);
+		printf("valid: %d, ",
+		       ec_verify_batch(items, NB_ITEMS, results));
+		for (same = 1, j = 0; j < NB_ITEMS; j++)
+			same &= results[j] == ec_verify(items[j].key,
+							items[j].msg,
+							items[j].msglen,
+							items[j].sig);
+		printf("same as ec_verify: %d\n", same);
+	}
+
+	/* Batches from two threads at once */
+	hblk_verify_pool_init(3);
+	pthread_create(&thread, NULL, _batch, other);
+	ec_verify_batch(items, NB_ITEMS, results);
+	pthread_join(thread, NULL);
+	printf("Concurrent: %d\n", !memcmp(results, other, sizeof(results)));
+
+	printf("Empty: %d, NULL: %d %d\n", ec_verify_batch(items, 0, results),
+	       ec_verify_batch(NULL, 1, results),
+	       ec_verify_batch(items, 1, NULL));
+	hblk_verify_pool_destroy();
+	printf("Restarted: %d\n", ec_verify_batch(items + 1, 1, results));
+	hblk_verify_pool_destroy();
+
+	for (i = 0; i < NB_KEYS; i++)
+		EC_KEY_free(keys[i]);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "hblk_crypto.h"
+
+#define NB_THREADS	4
+#define NB_VALUES	1000000
+#define NB_SIGS		50
+
+static hblk_hist_t hists[NB_THREADS];
+
+/**
+ * _record - Records the values 1 to NB_VALUES in a histogram of its own
+ *
+ * @arg: Pointer to the histogram
+ *
+ * Return: NULL
+ */
+static void *_record(void *arg)
+{
+	uint64_t i;
+
+	for (i = 1; i <= NB_VALUES; i++)
+		hblk_hist_record(arg, i);
+	hblk_latency_record(HBLK_LAT_EC_SIGN, 1000);
+
+	return (NULL);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	static hblk_hist_t hist;
+	pthread_t threads[NB_THREADS];
+	uint8_t digest[SHA256_DIGEST_LENGTH] = {0};
+	EC_KEY *key = ec_create();
+	double percentiles[] = {0, 50, 90, 99, 99.9, 100};
+	uint64_t value;
+	sig_t sig;
+	int i;
+
+	for (i = 0; i < NB_THREADS; i++)
+		pthread_create(&threads[i], NULL, _record, &hists[i]);
+	for (i = 0; i < NB_THREADS; i++)
+	{
+		pthread_join(threads[i], NULL);
+		hblk_hist_merge(&hist, &hists[i]);
+	}
+	printf("Merged: %lu values, sum %lu\n", (unsigned long)hist.count,
+	       (unsigned long)hist.sum);
+	for (i = 0; i < 6; i++)
+	{
+		value = hblk_hist_percentile(&hist, percentiles[i]);
+		printf("p%g: %lu, within 1/32: %d\n", percentiles[i],
+		       (unsigned long)value,
+		       value >= percentiles[i] / 100 * NB_VALUES &&
+		       value <= percentiles[i] / 100 * NB_VALUES * 33 / 32 + 1);
+	}
+	hblk_hist_clear(&hist);
+	hblk_hist_record(&hist, UINT64_MAX);
+	printf("Largest: %d\n", hblk_hist_percentile(&hist, 50) == UINT64_MAX);
+
+	/* Threads that exited are still accounted for, until a reset */
+	hblk_latency_get(HBLK_LAT_EC_SIGN, &hist);
+	printf("ec_sign before reset: %lu\n", (unsigned long)hist.count);
+	hblk_latency_reset();
+	for (i = 0; i < NB_SIGS; i++)
+	{
+		ec_sign(key, digest, SHA256_DIGEST_LENGTH, &sig);
+		ec_verify(key, digest, SHA256_DIGEST_LENGTH, &sig);
+	}
+	hblk_latency_get(HBLK_LAT_EC_SIGN, &hist);
+	printf("ec_sign: %lu, ", (unsigned long)hist.count);
+	hblk_latency_get(HBLK_LAT_EC_VERIFY, &hist);
+	printf("ec_verify: %lu, ordered: %d\n", (unsigned long)hist.count,
+	       hist.min <= hblk_hist_percentile(&hist, 50) &&
+	       hblk_hist_percentile(&hist, 50) <=
+	       hblk_hist_percentile(&hist, 99.9) &&
+	       hblk_hist_percentile(&hist, 99.9) <= hist.max);
+	printf("Invalid: %d %p\n", hblk_latency_get(HBLK_LAT_MAX, &hist),
+	       (void *)hblk_latency_name(HBLK_LAT_MAX));
+	hblk_latency_print(stdout);
+
+	EC_KEY_free(key);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,77 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hblk_crypto.h"
+#include "hblk_key_cache.h"
+
+#define NB_KEYS		6
+#define CAPACITY	4
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	uint8_t pubs[NB_KEYS][EC_PUB_LEN], digest[SHA256_DIGEST_LENGTH] = {0};
+	EC_KEY *keys[NB_KEYS], *key, *again;
+	sig_t sigs[NB_KEYS];
+	int i, valid = 0;
+
+	for (i = 0; i < NB_KEYS; i++)
+	{
+		keys[i] = ec_create();
+		ec_to_pub(keys[i], pubs[i]);
+		ec_sign(keys[i], digest, SHA256_DIGEST_LENGTH, &sigs[i]);
+	}
+	printf("Shared group: %d\n", hblk_ec_group() == hblk_ec_group() &&
+	       EC_GROUP_get_curve_name(hblk_ec_group()) == EC_CURVE);
+
+	/* Disabled by default: every call decodes */
+	key = ec_from_pub(pubs[0]);
+	again = ec_from_pub(pubs[0]);
+	printf("Disabled: distinct %d, misses %lu\n", key != again,
+	       (unsigned long)hblk_stat_get(HBLK_STAT_KEY_CACHE_MISS));
+	EC_KEY_free(key);
+	EC_KEY_free(again);
+
+	hblk_key_cache_init(CAPACITY);
+	for (i = 0; i < NB_KEYS; i++)
+	{
+		key = ec_from_pub(pubs[i]);
+		valid += ec_verify(key, digest, SHA256_DIGEST_LENGTH, &sigs[i]);
+		EC_KEY_free(key);
+	}
+	/* The 4 most recent keys are cached, the 2 oldest were evicted */
+	key = ec_from_pub(pubs[NB_KEYS - 1]);
+	again = ec_from_pub(pubs[NB_KEYS - 1]);
+	printf("Same key: %d, valid: %d\n", key == again, valid +
+	       ec_verify(again, digest, SHA256_DIGEST_LENGTH,
+			 &sigs[NB_KEYS - 1]));
+	EC_KEY_free(key);
+	EC_KEY_free(again);
+	EC_KEY_free(ec_from_pub(pubs[0]));
+	printf("hit: %lu, miss: %lu, evict: %lu\n",
+	       (unsigned long)hblk_stat_get(HBLK_STAT_KEY_CACHE_HIT),
+	       (unsigned long)hblk_stat_get(HBLK_STAT_KEY_CACHE_MISS),
+	       (unsigned long)hblk_stat_get(HBLK_STAT_KEY_CACHE_EVICT));
+
+	/* An invalid point is not cached */
+	pubs[1][1] ^= 1;
+	printf("Invalid: %p %p\n", (void *)ec_from_pub(pubs[1]),
+	       (void *)ec_from_pub(pubs[1]));
+
+	/* Keys still referenced outlive the cache */
+	key = ec_from_pub(pubs[2]);
+	hblk_key_cache_clear();
+	hblk_key_cache_init(0);
+	printf("After disable: %d\n",
+	       ec_verify(key, digest, SHA256_DIGEST_LENGTH, &sigs[2]));
+	EC_KEY_free(key);
+
+	for (i = 0; i < NB_KEYS; i++)
+		EC_KEY_free(keys[i]);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,94 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "hblk_crypto.h"
+#include "hblk_sig_cache.h"
+
+#define NB_THREADS	4
+#define NB_SIGS		16
+
+static EC_KEY *key;
+static uint8_t msgs[NB_SIGS][SHA256_DIGEST_LENGTH];
+static sig_t sigs[NB_SIGS];
+
+/**
+ * _verify - Verifies every signature several times from a thread
+ *
+ * @arg: Address of the number of valid signatures to set
+ *
+ * Return: NULL
+ */
+static void *_verify(void *arg)
+{
+	int i, *valid = arg;
+
+	for (i = 0; i < 4 * NB_SIGS; i++)
+		*valid += ec_verify(key, msgs[i % NB_SIGS],
+				    SHA256_DIGEST_LENGTH, &sigs[i % NB_SIGS]);
+
+	return (NULL);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	pthread_t threads[NB_THREADS];
+	int valid[NB_THREADS] = {0};
+	uint8_t id[SHA256_DIGEST_LENGTH];
+	EC_KEY *other = ec_create();
+	sig_t bad;
+	int i, total = 0;
+
+	key = ec_create();
+	for (i = 0; i < NB_SIGS; i++)
+	{
+		sha256((int8_t const *)&i, sizeof(i), msgs[i]);
+		ec_sign(key, msgs[i], SHA256_DIGEST_LENGTH, &sigs[i]);
+	}
+	printf("Disabled: %d\n", hblk_sig_cache_id(key, msgs[0],
+						   SHA256_DIGEST_LENGTH,
+						   &sigs[0], id));
+
+	hblk_sig_cache_init(HBLK_SIG_CACHE_SIZE);
+	hblk_stats_reset();
+	for (i = 0; i < NB_THREADS; i++)
+		pthread_create(&threads[i], NULL, _verify, &valid[i]);
+	for (i = 0; i < NB_THREADS; i++)
+	{
+		pthread_join(threads[i], NULL);
+		total += valid[i];
+	}
+	printf("Valid: %d, ECDSA verifications: %d\n", total,
+	       hblk_stat_get(HBLK_STAT_EC_VERIFY) <= NB_THREADS * NB_SIGS);
+	printf("Hits: %d\n", hblk_stat_get(HBLK_STAT_SIG_CACHE_HIT) >=
+	       (NB_THREADS * 4 - NB_THREADS) * NB_SIGS);
+
+	/* Failures are not cached, and any change of the triple misses */
+	bad = sigs[0];
+	bad.sig[bad.len - 1] ^= 1;
+	printf("Bad: %d %d, ", ec_verify(key, msgs[0], SHA256_DIGEST_LENGTH,
+				       &bad),
+	       ec_verify(key, msgs[0], SHA256_DIGEST_LENGTH, &bad));
+	printf("other key: %d, other message: %d\n",
+	       ec_verify(other, msgs[0], SHA256_DIGEST_LENGTH, &sigs[0]),
+	       ec_verify(key, msgs[1], SHA256_DIGEST_LENGTH, &sigs[0]));
+
+	/* A tiny cache stays bounded and correct */
+	hblk_sig_cache_init(1);
+	for (total = 0, i = 0; i < 2 * NB_SIGS; i++)
+		total += ec_verify(key, msgs[i % NB_SIGS],
+				   SHA256_DIGEST_LENGTH, &sigs[i % NB_SIGS]);
+	printf("Tiny cache: %d\n", total);
+	hblk_sig_cache_clear();
+	hblk_sig_cache_init(0);
+
+	EC_KEY_free(other);
+	EC_KEY_free(key);
+	return (EXIT_SUCCESS);
+}
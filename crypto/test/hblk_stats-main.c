@@ -0,0 +1,80 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "hblk_crypto.h"
+
+#define NB_THREADS	4
+#define NB_SIGS		100
+#define NB_ADDS		1000000
+
+/**
+ * _count - Updates a counter from a thread
+ *
+ * @arg: Unused
+ *
+ * Return: NULL
+ */
+static void *_count(void *arg)
+{
+	int i;
+
+	(void)arg;
+	for (i = 0; i < NB_ADDS; i++)
+		hblk_stat_add(HBLK_STAT_BLOCK_ALLOC, 1);
+
+	return (NULL);
+}
+
+/**
+ * main - Entry point
+ *
+ * Return: EXIT_SUCCESS or EXIT_FAILURE
+ */
+int main(void)
+{
+	uint8_t const str[] = "Holberton";
+	uint8_t digest[SHA256_DIGEST_LENGTH];
+	pthread_t threads[NB_THREADS];
+	EC_KEY *key = ec_create();
+	sig_t sig;
+	int i, valid = 0;
+
+	for (i = 0; i < NB_SIGS; i++)
+	{
+		sha256((int8_t const *)str, strlen((char *)str), digest);
+		ec_sign(key, digest, SHA256_DIGEST_LENGTH, &sig);
+		valid += ec_verify(key, digest, SHA256_DIGEST_LENGTH, &sig);
+	}
+	printf("Valid: %d\n", valid);
+	printf("%s: %lu, %s: %lu\n", hblk_stat_name(HBLK_STAT_SHA256),
+	       (unsigned long)hblk_stat_get(HBLK_STAT_SHA256),
+	       hblk_stat_name(HBLK_STAT_SHA256_BYTES),
+	       (unsigned long)hblk_stat_get(HBLK_STAT_SHA256_BYTES));
+	printf("ec_sign: %lu, ec_verify: %lu, timed: %d\n",
+	       (unsigned long)hblk_stat_get(HBLK_STAT_EC_SIGN),
+	       (unsigned long)hblk_stat_get(HBLK_STAT_EC_VERIFY),
+	       hblk_stat_get(HBLK_STAT_EC_SIGN_NS) > 0 &&
+	       hblk_stat_get(HBLK_STAT_EC_VERIFY_NS) > 0);
+
+	/* Threads that exited are still accounted for */
+	for (i = 0; i < NB_THREADS; i++)
+		pthread_create(&threads[i], NULL, _count, NULL);
+	for (i = 0; i < NB_THREADS; i++)
+		pthread_join(threads[i], NULL);
+	printf("block_alloc: %lu\n",
+	       (unsigned long)hblk_stat_get(HBLK_STAT_BLOCK_ALLOC));
+
+	hblk_stats_reset();
+	ec_verify(key, digest, SHA256_DIGEST_LENGTH, &sig);
+	printf("After reset: ec_verify: %lu, block_alloc: %lu\n",
+	       (unsigned long)hblk_stat_get(HBLK_STAT_EC_VERIFY),
+	       (unsigned long)hblk_stat_get(HBLK_STAT_BLOCK_ALLOC));
+	printf("Invalid: %lu %p\n", (unsigned long)hblk_stat_get(HBLK_STAT_MAX),
+	       (void *)hblk_stat_name(HBLK_STAT_MAX));
+	hblk_stats_print(stdout);
+
+	EC_KEY_free(key);
+	return (EXIT_SUCCESS);
+}